@@ -12,10 +12,12 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include "compiler.hpp"
 #include "exceptions.hpp"
 #include "logging.hpp"
 #include "arg_parser.hpp"
+#include "workers.hpp"
 
 namespace Error {
     namespace Colors {
@@ -62,14 +64,17 @@ const char *Error::get_code_name(Error::ErrorCode code){
 
 void Error::error(Error::ErrorCode code, const char *msg, Exception::EbeException *exc, bool exit){
     if(!Args::arg_opts.no_error_print) {
-        std::cerr << Error::Colors::colorize(Error::Colors::RED) << "ERROR" << Error::Colors::reset() 
-                << " (" << Error::get_code_name(code); 
+        // Message is written at once, so that messages from multiple threads don't interleave
+        std::stringstream err;
+        err << Error::Colors::colorize(Error::Colors::RED) << "ERROR" << Error::Colors::reset() 
+            << " (" << Error::get_code_name(code); 
         if(exc == nullptr) {
-            std::cerr << "): " << msg << "." << std::endl;
+            err << "): " << msg << "." << std::endl;
         }
         else {
-            std::cerr << ", " << exc->get_type() << "): " << msg << ". " << exc->what() << "." << std::endl;
+            err << ", " << exc->get_type() << "): " << msg << ". " << exc->what() << "." << std::endl;
         }
+        std::cerr << err.str() << std::flush;
     }
     if(exit){
         Error::exit(code);
@@ -78,7 +83,9 @@ void Error::error(Error::ErrorCode code, const char *msg, Exception::EbeExceptio
 
 void Error::warning(const char *msg) {
     if(!Args::arg_opts.no_warn_print) {
-        std::cerr << Colors::colorize(Colors::PURPLE) << "WARNING: " << Colors::reset() << msg << "." << std::endl;
+        std::stringstream err;
+        err << Colors::colorize(Colors::PURPLE) << "WARNING: " << Colors::reset() << msg << "." << std::endl;
+        std::cerr << err.str() << std::flush;
     }
 }
 
@@ -87,31 +94,34 @@ void Compiler::error(Error::ErrorCode code, const char *file,
                                   long line, long column, const char *msg,
                                   Exception::EbeException *exc, bool exit){
     if(!Args::arg_opts.no_error_print) {
+        // Message is written at once, so that messages from multiple threads don't interleave
+        std::stringstream err;
         if(file) {
             // Dont print name if it is nullptr
-            std::cerr << file;
+            err << file;
             if(line < 0) {
-                std::cerr << ":";
+                err << ":";
             }
         }
         if(line >= 0){
-            std::cerr << ":" << line;
+            err << ":" << line;
             if(column >= 0) {
-                std::cerr << ":" << column;
+                err << ":" << column;
             }
-            std::cerr << ":";
+            err << ":";
         }
 #ifdef DEVELOPER
-        std::cerr << "[" << unit_name << "]: ";
+        err << "[" << unit_name << "]: ";
 #endif
-        std::cerr << Error::Colors::colorize(Error::Colors::RED) << "ERROR " 
-                  << Error::Colors::reset() << "(" << Error::get_code_name(code);
+        err << Error::Colors::colorize(Error::Colors::RED) << "ERROR " 
+            << Error::Colors::reset() << "(" << Error::get_code_name(code);
         if(exc == nullptr) {
-            std::cerr << "): " << msg << "." << std::endl;
+            err << "): " << msg << "." << std::endl;
         }
         else {
-            std::cerr << ", " << exc->get_type() << "): " << msg << ". " << exc->what() << "." << std::endl;
+            err << ", " << exc->get_type() << "): " << msg << ". " << exc->what() << "." << std::endl;
         }
+        std::cerr << err.str() << std::flush;
     }
     if(exit){
         Error::exit(code);
@@ -119,6 +129,9 @@ void Compiler::error(Error::ErrorCode code, const char *file,
 }
 
 [[noreturn]] void Error::exit(Error::ErrorCode code) {
+    if(WorkerPool::in_task()) {
+        throw Error::ExitRequest{code};
+    }
     LOG1("Exiting program with code " << code);
     std::exit(code);
 }
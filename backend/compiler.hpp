@@ -130,8 +130,18 @@ namespace Error {
      */ 
     void warning(const char *msg);
 
+    /**
+     * Request to exit the program thrown from a worker pool task
+     * Exiting directly from a worker thread would destroy the pool on that thread,
+     * so the pool catches this and exits from the calling thread after the batch
+     */
+    struct ExitRequest {
+        Error::ErrorCode code; ///< Code to exit with
+    };
+
     /**
      * Exits program with passed in code
+     * When called from a parallel worker pool task, ExitRequest is thrown instead
      * @param code Error code to exit with
      */ 
     [[noreturn]] void exit(Error::ErrorCode code);
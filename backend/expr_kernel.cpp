@@ -0,0 +1,370 @@
+/**
+ * @file expr_kernel.cpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Compiled expression passes
+ *
+ * Type specialized code for expression passes with statically known types
+ */
+
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "expr_kernel.hpp"
+#include "instruction.hpp"
+#include "symbol_table.hpp"
+#include "ir.hpp"
+#include "utils.hpp"
+
+using namespace Inst;
+
+namespace {
+
+    /** @return True if operation throws when its 2nd argument is zero */
+    inline bool is_division(ExprKernel::Op op) {
+        return op == ExprKernel::Op::DIV_NUMBER || op == ExprKernel::Op::MOD_NUMBER
+            || op == ExprKernel::Op::DIV_FLOAT || op == ExprKernel::Op::MOD_FLOAT;
+    }
+
+    /** @return True if division's 2nd argument is zero */
+    inline bool is_zero(ExprKernel::Op op, ExprKernel::Value value) {
+        if(op == ExprKernel::Op::DIV_NUMBER || op == ExprKernel::Op::MOD_NUMBER) {
+            return value.number == 0;
+        }
+        return value.real == 0.0f;
+    }
+
+    /**
+     * Executes binary operation for a column of values
+     * @param f Operation on 2 values
+     */
+    template<typename F>
+    inline void column_op(ExprKernel::Value *dst, const ExprKernel::Value *a, const ExprKernel::Value *b,
+                          size_t count, F f) {
+        for(size_t i = 0; i < count; ++i) {
+            dst[i] = f(a[i], b[i]);
+        }
+    }
+}
+
+ExprKernel::ExprKernel() : variables{0}, input_type{IR::Type::DERIVED}, failing{false} {
+
+}
+
+int ExprKernel::add_constant(IR::Type type, Value value) {
+    // Same constants share a slot
+    for(size_t slot = variables; slot < slots.size(); ++slot) {
+        if(types[slot] == type && slots[slot].number == value.number) {
+            return static_cast<int>(slot);
+        }
+    }
+    int slot = static_cast<int>(slots.size());
+    slots.push_back(value);
+    types.push_back(type);
+    constants.push_back(slot);
+    return slot;
+}
+
+int ExprKernel::operand(int index, Vars::Variable *value) {
+    if(index >= 0) {
+        // Variable out of range is reported by generic interpretation
+        if(index >= variables) {
+            return -1;
+        }
+        // Value known during compilation is used directly
+        return constants[index] >= 0 ? constants[index] : index;
+    }
+    if(value == nullptr) {
+        return -1;
+    }
+    Value v{};
+    if(value->type == IR::Type::NUMBER) {
+        v.number = value->get_number();
+    }
+    else if(value->type == IR::Type::FLOAT) {
+        v.real = value->get_float();
+    }
+    else if(value->type == IR::Type::TEXT) {
+        // Text values are never computed with, so all text constants share one slot without a value
+        v.number = 0;
+    }
+    else {
+        return -1;
+    }
+    return add_constant(value->type, v);
+}
+
+void ExprKernel::fail() {
+    failing = true;
+    code.assign(1, KernelInst{Op::FAIL, 0, 0, 0});
+}
+
+bool ExprKernel::add_move(int dst, int isrc1, Vars::Variable *src1) {
+    if(dst < 0 || dst >= variables) {
+        return false;
+    }
+    if(isrc1 == dst) {
+        // MOVE $, $
+        return true;
+    }
+    int src = operand(isrc1, src1);
+    if(src < 0) {
+        return false;
+    }
+    if(types[src] == IR::Type::DERIVED) {
+        fail();
+        return true;
+    }
+    types[dst] = types[src];
+    constants[dst] = constants[src];
+    // Text is only tracked for its type, it can only be overwritten or fail
+    if(types[src] == IR::Type::TEXT) {
+        constants[dst] = -1;
+        return true;
+    }
+    code.push_back(KernelInst{Op::MOVE, dst, src, 0});
+    return true;
+}
+
+bool ExprKernel::add_arithmetic(const char *name, int dst, int isrc1, Vars::Variable *src1,
+                                int isrc2, Vars::Variable *src2) {
+    if(dst < 0 || dst >= variables) {
+        return false;
+    }
+    int a = operand(isrc1, src1);
+    int b = operand(isrc2, src2);
+    if(a < 0 || b < 0) {
+        return false;
+    }
+    // Type errors and undefined variables fail for every word
+    IR::Type type = types[a];
+    if(type != types[b] || (type != IR::Type::NUMBER && type != IR::Type::FLOAT)) {
+        fail();
+        return true;
+    }
+    const bool number = type == IR::Type::NUMBER;
+    Op op;
+    if(name == ADD::NAME) {
+        op = number ? Op::ADD_NUMBER : Op::ADD_FLOAT;
+    }
+    else if(name == SUB::NAME) {
+        op = number ? Op::SUB_NUMBER : Op::SUB_FLOAT;
+    }
+    else if(name == MUL::NAME) {
+        op = number ? Op::MUL_NUMBER : Op::MUL_FLOAT;
+    }
+    else if(name == DIV::NAME) {
+        op = number ? Op::DIV_NUMBER : Op::DIV_FLOAT;
+    }
+    else if(name == MOD::NAME) {
+        op = number ? Op::MOD_NUMBER : Op::MOD_FLOAT;
+    }
+    else if(name == POW::NAME) {
+        op = number ? Op::POW_NUMBER : Op::POW_FLOAT;
+    }
+    else {
+        return false;
+    }
+    types[dst] = type;
+    // Constant folding, division by zero is left to fail on every word
+    if(constants[a] >= 0 && constants[b] >= 0 && !(is_division(op) && is_zero(op, slots[b]))) {
+        int folded = add_constant(type, apply(op, slots[a], slots[b]));
+        constants[dst] = folded;
+        code.push_back(KernelInst{Op::MOVE, dst, folded, 0});
+        return true;
+    }
+    constants[dst] = -1;
+    code.push_back(KernelInst{op, dst, a, b});
+    return true;
+}
+
+void ExprKernel::eliminate_dead_code() {
+    std::vector<bool> live(slots.size(), false);
+    live[0] = true;
+    std::vector<KernelInst> used;
+    for(auto inst = code.rbegin(); inst != code.rend(); ++inst) {
+        // Division is kept even when not used, since it might fail
+        if(!live[inst->dst] && !is_division(inst->op)) {
+            continue;
+        }
+        live[inst->dst] = false;
+        live[inst->src1] = true;
+        if(inst->op != Op::MOVE) {
+            live[inst->src2] = true;
+        }
+        used.push_back(*inst);
+    }
+    code.assign(used.rbegin(), used.rend());
+}
+
+bool ExprKernel::compile(IR::Type input, const std::vector<Instruction *> &pipeline, int variables) {
+    code.clear();
+    columns.clear();
+    column_of.clear();
+    slots.clear();
+    types.clear();
+    constants.clear();
+    failing = false;
+    if((input != IR::Type::NUMBER && input != IR::Type::FLOAT && input != IR::Type::TEXT) || variables <= 0) {
+        return false;
+    }
+    this->input_type = input;
+    this->variables = variables;
+    slots.resize(variables);
+    types.assign(variables, IR::Type::DERIVED);
+    constants.assign(variables, -1);
+    types[0] = input;
+    for(auto inst: pipeline) {
+        auto expr_inst = dynamic_cast<ExprInstruction *>(inst);
+        if(expr_inst == nullptr || !expr_inst->compile(*this)) {
+            return false;
+        }
+        if(failing) {
+            return true;
+        }
+    }
+    // Result has to be a number for the same reason as input
+    if(types[0] != IR::Type::NUMBER && types[0] != IR::Type::FLOAT) {
+        return false;
+    }
+    eliminate_dead_code();
+    return true;
+}
+
+ExprKernel::Value ExprKernel::apply(Op op, Value a, Value b) {
+    Value r{};
+    switch(op) {
+    case Op::MOVE: r = a; break;
+    case Op::ADD_NUMBER: r.number = a.number + b.number; break;
+    case Op::SUB_NUMBER: r.number = a.number - b.number; break;
+    case Op::MUL_NUMBER: r.number = a.number * b.number; break;
+    case Op::DIV_NUMBER: r.number = a.number / b.number; break;
+    case Op::MOD_NUMBER: r.number = a.number % b.number; break;
+    case Op::POW_NUMBER: r.number = static_cast<int>(std::pow(a.number, b.number)); break;
+    case Op::ADD_FLOAT: r.real = a.real + b.real; break;
+    case Op::SUB_FLOAT: r.real = a.real - b.real; break;
+    case Op::MUL_FLOAT: r.real = a.real * b.real; break;
+    case Op::DIV_FLOAT: r.real = a.real / b.real; break;
+    case Op::MOD_FLOAT: r.real = std::fmod(a.real, b.real); break;
+    case Op::POW_FLOAT: r.real = std::pow(a.real, b.real); break;
+    case Op::FAIL: r = a; break;
+    }
+    return r;
+}
+
+bool ExprKernel::can_fail() const {
+    if(failing) {
+        return true;
+    }
+    for(const auto &inst: code) {
+        if(is_division(inst.op) && (constants[inst.src2] < 0 || is_zero(inst.op, slots[inst.src2]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ExprKernel::Value ExprKernel::read(IR::Word *word) const {
+    Value value{};
+    if(input_type == IR::Type::NUMBER) {
+        value.number = word->to_int<IR::Type::NUMBER>();
+    }
+    else if(input_type == IR::Type::FLOAT) {
+        value.real = word->to_float<IR::Type::FLOAT>();
+    }
+    else {
+        // Text $0 is never used as a value
+        value.number = 0;
+    }
+    return value;
+}
+
+void ExprKernel::write(IR::Word *word, Value value) const {
+    char buffer[Cast::FORMAT_BUFFER_SIZE];
+    if(types[0] == IR::Type::NUMBER) {
+        word->set(Cast::format(value.number, buffer), IR::Type::NUMBER);
+    }
+    else {
+        word->set(Cast::format(value.real, buffer), IR::Type::FLOAT);
+    }
+}
+
+void ExprKernel::load(IR::Word *word) {
+    slots[0] = read(word);
+}
+
+bool ExprKernel::exec() {
+    Value *s = slots.data();
+    for(const auto &inst: code) {
+        if(inst.op == Op::MOVE) {
+            s[inst.dst] = s[inst.src1];
+            continue;
+        }
+        if(inst.op == Op::FAIL || (is_division(inst.op) && is_zero(inst.op, s[inst.src2]))) {
+            return false;
+        }
+        s[inst.dst] = apply(inst.op, s[inst.src1], s[inst.src2]);
+    }
+    return true;
+}
+
+void ExprKernel::store(IR::Word *word) {
+    write(word, slots[0]);
+}
+
+void ExprKernel::prepare_columns() {
+    column_of.assign(slots.size(), -1);
+    int used = 0;
+    column_of[0] = used++;
+    for(const auto &inst: code) {
+        for(int slot: {inst.dst, inst.src1, inst.op == Op::MOVE ? inst.src1 : inst.src2}) {
+            if(column_of[slot] < 0) {
+                column_of[slot] = used++;
+            }
+        }
+    }
+    columns.resize(used * COLUMN_SIZE);
+    // Constants are never overwritten, so their columns are filled only once
+    for(size_t slot = 0; slot < slots.size(); ++slot) {
+        if(column_of[slot] >= 0 && constants[slot] == static_cast<int>(slot)) {
+            std::fill_n(columns.begin() + column_of[slot] * COLUMN_SIZE, COLUMN_SIZE, slots[slot]);
+        }
+    }
+}
+
+void ExprKernel::exec_column(Value *values, size_t count) {
+    if(columns.empty()) {
+        prepare_columns();
+    }
+    auto column = [this](int slot) { return columns.data() + column_of[slot] * COLUMN_SIZE; };
+    Value *input = column(0);
+    std::copy(values, values + count, input);
+    for(const auto &inst: code) {
+        Value *dst = column(inst.dst);
+        const Value *a = column(inst.src1);
+        if(inst.op == Op::MOVE) {
+            std::copy(a, a + count, dst);
+            continue;
+        }
+        const Value *b = column(inst.src2);
+        // Operation is resolved once for the whole column
+        switch(inst.op) {
+        case Op::ADD_NUMBER: column_op(dst, a, b, count, [](Value x, Value y) { Value r{}; r.number = x.number + y.number; return r; }); break;
+        case Op::SUB_NUMBER: column_op(dst, a, b, count, [](Value x, Value y) { Value r{}; r.number = x.number - y.number; return r; }); break;
+        case Op::MUL_NUMBER: column_op(dst, a, b, count, [](Value x, Value y) { Value r{}; r.number = x.number * y.number; return r; }); break;
+        case Op::ADD_FLOAT: column_op(dst, a, b, count, [](Value x, Value y) { Value r{}; r.real = x.real + y.real; return r; }); break;
+        case Op::SUB_FLOAT: column_op(dst, a, b, count, [](Value x, Value y) { Value r{}; r.real = x.real - y.real; return r; }); break;
+        case Op::MUL_FLOAT: column_op(dst, a, b, count, [](Value x, Value y) { Value r{}; r.real = x.real * y.real; return r; }); break;
+        case Op::DIV_FLOAT: column_op(dst, a, b, count, [](Value x, Value y) { Value r{}; r.real = x.real / y.real; return r; }); break;
+        default:
+            // Operations without vector instructions (integer division, modulo and power)
+            for(size_t i = 0; i < count; ++i) {
+                dst[i] = apply(inst.op, a[i], b[i]);
+            }
+            break;
+        }
+    }
+    std::copy(input, input + count, values);
+}
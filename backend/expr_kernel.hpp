@@ -0,0 +1,195 @@
+/**
+ * @file expr_kernel.hpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Compiled expression passes
+ *
+ * Type specialized code for expression passes with statically known types
+ */
+
+#ifndef _EXPR_KERNEL_HPP_
+#define _EXPR_KERNEL_HPP_
+
+#include <vector>
+#include <cstdint>
+#include "ir.hpp"
+
+namespace Vars {
+    class Variable;
+}
+
+namespace Inst {
+
+    class Instruction;
+
+    /**
+     * Expression pass compiled into straight-line code
+     * Pass input type fixes type of $0 and so types of all variables can be inferred
+     * before processing any word. Every instruction is then compiled into an operation
+     * for one type, which does not need any type checking, and operations with
+     * constant arguments are evaluated during compilation.
+     * Instruction which fails on a type error or an undefined variable fails for
+     * every word, so such code is compiled into a single FAIL operation.
+     * Compilation fails (and the generic interpretation has to be used) when $0 is
+     * undefined (EMPTY word), when the result is not a number or for instructions
+     * without a compiled form (e.g. variables out of range).
+     * Failures are reported by return values, so that failing words are cheap.
+     */
+    class ExprKernel {
+    public:
+        /** Value of a variable or constant */
+        union Value {
+            int number;  ///< NUMBER value
+            float real;  ///< FLOAT value
+        };
+
+        /** Type specialized operations */
+        enum class Op : uint8_t {
+            MOVE,
+            ADD_NUMBER,
+            SUB_NUMBER,
+            MUL_NUMBER,
+            DIV_NUMBER,
+            MOD_NUMBER,
+            POW_NUMBER,
+            ADD_FLOAT,
+            SUB_FLOAT,
+            MUL_FLOAT,
+            DIV_FLOAT,
+            MOD_FLOAT,
+            POW_FLOAT,
+            FAIL      ///< Fails for every word
+        };
+
+        /** Compiled operation working with slots (variables followed by constants) */
+        struct KernelInst {
+            Op op;            ///< Operation
+            int dst;          ///< Destination slot
+            int src1;         ///< 1st argument slot
+            int src2;         ///< 2nd argument slot (not used by MOVE)
+        };
+
+        /** Maximal amount of words evaluated at once by exec_column */
+        static const size_t COLUMN_SIZE = 1024;
+    private:
+        int variables;                   ///< Amount of variables (symbol table size)
+        std::vector<KernelInst> code;    ///< Compiled code
+        std::vector<Value> slots;        ///< Variables followed by constants
+        std::vector<IR::Type> types;     ///< Inferred type of each slot (DERIVED for undefined)
+        std::vector<int> constants;      ///< Constant slot holding value of a slot, or -1 when not known
+        IR::Type input_type;             ///< Type of $0 on input
+        bool failing;                    ///< Compiled code fails for every word
+        std::vector<Value> columns;      ///< Column of COLUMN_SIZE values for each used slot (allocated on first use)
+        std::vector<int> column_of;      ///< Column index of each slot or -1 if the slot is not used
+
+        /**
+         * Resolves argument of an instruction into a slot
+         * @param index Variable index or -1 for a constant
+         * @param value Constant argument
+         * @return Slot of the argument (its type is DERIVED for undefined variable)
+         *         or -1 if it cannot be compiled
+         */
+        int operand(int index, Vars::Variable *value);
+
+        /**
+         * Adds a constant slot
+         * @param type Constant type
+         * @param value Constant value
+         * @return Index of the slot
+         */
+        int add_constant(IR::Type type, Value value);
+
+        /** Replaces compiled code with FAIL, rest of the instructions is not compiled */
+        void fail();
+
+        /** Removes operations which results are never used */
+        void eliminate_dead_code();
+
+        /** Allocates columns for used slots and fills in constants */
+        void prepare_columns();
+    public:
+        /** Constructor */
+        ExprKernel();
+
+        /**
+         * Compiles expression pass
+         * @param input Type of $0 (NUMBER, FLOAT or TEXT)
+         * @param pipeline Pass instructions
+         * @param variables Symbol table size
+         * @return True if the pass was compiled, false if generic interpretation has to be used
+         */
+        bool compile(IR::Type input, const std::vector<Instruction *> &pipeline, int variables);
+
+        /**
+         * Compiles MOVE instruction
+         * @return True if the instruction can be compiled
+         */
+        bool add_move(int dst, int isrc1, Vars::Variable *src1);
+
+        /**
+         * Compiles arithmetic instruction
+         * @param name Instruction name (NAME of the instruction class)
+         * @return True if the instruction can be compiled
+         */
+        bool add_arithmetic(const char *name, int dst, int isrc1, Vars::Variable *src1, int isrc2, Vars::Variable *src2);
+
+        /**
+         * Computes result of an arithmetic operation
+         * @param op Arithmetic operation
+         * @param a 1st argument
+         * @param b 2nd argument (non zero for division and modulo)
+         * @return Result
+         */
+        static Value apply(Op op, Value a, Value b);
+
+        /**
+         * @return True if execution might fail (division by a variable or by zero, or FAIL)
+         */
+        bool can_fail() const;
+
+        /**
+         * @param word Word of pass type
+         * @return Word's value as $0
+         */
+        Value read(IR::Word *word) const;
+
+        /**
+         * Saves value of $0 into the word
+         * @param word Word to be modified
+         * @param value Value of $0
+         */
+        void write(IR::Word *word, Value value) const;
+
+        /**
+         * Sets $0 to the word's value
+         * @param word Word of pass type
+         */
+        void load(IR::Word *word);
+
+        /**
+         * Executes compiled code
+         * @return False if the code failed (division by zero or FAIL), $0 must not be stored then
+         */
+        bool exec();
+
+        /**
+         * Saves value of $0 into the word
+         * @param word Word to be modified
+         */
+        void store(IR::Word *word);
+
+        /**
+         * Executes compiled code on multiple values of $0 at once
+         * Every operation is executed for the whole column, so that the loops can be vectorized.
+         * @param values Values of $0, replaced with results
+         * @param count Amount of values (at most COLUMN_SIZE)
+         * @note Can be used only when can_fail returns false
+         */
+        void exec_column(Value *values, size_t count);
+    };
+
+}
+
+#endif//_EXPR_KERNEL_HPP_
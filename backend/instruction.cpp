@@ -21,6 +21,8 @@
 #include "rng.hpp"
 #include "logging.hpp"
 #include "symbol_table.hpp"
+#include "binary.hpp"
+#include "expr_kernel.hpp"
 
 #include <iostream>
 
@@ -68,6 +70,44 @@ inline void MOVE::format_args(std::ostream &out) {
         out << *src1;
 }
 
+void ArithmeticInstruction::write_args(Utils::BinaryWriter &out) {
+    // Value is written only when variable index is not used
+    out.write_i32(this->dst);
+    out.write_i32(this->isrc1);
+    out.write_i32(this->isrc2);
+    if(isrc1 < 0)
+        src1->write(out);
+    if(isrc2 < 0)
+        src2->write(out);
+}
+
+void MOVE::write_args(Utils::BinaryWriter &out) {
+    out.write_i32(this->dst);
+    out.write_i32(this->isrc1);
+    if(isrc1 < 0)
+        src1->write(out);
+}
+
+bool ArithmeticInstruction::compile(ExprKernel &kernel) {
+    return kernel.add_arithmetic(get_name(), dst, isrc1, src1, isrc2, src2);
+}
+
+bool MOVE::compile(ExprKernel &kernel) {
+    return kernel.add_move(dst, isrc1, src1);
+}
+
+void CALL::write_args(Utils::BinaryWriter &out) {
+    out.write_u32(static_cast<uint32_t>(this->arg1));
+}
+
+void CONCAT::write_args(Utils::BinaryWriter &out) {
+    out.write_i32(this->arg1);
+}
+
+void SWAP::write_args(Utils::BinaryWriter &out) {
+    out.write_i32(this->arg1);
+}
+
 inline void CALL::format_args(std::ostream &out){
     out << this->arg1;
 }
@@ -110,6 +150,30 @@ Instruction *Inst::rand_instruction(IR::PassType, int pass_length, const Instruc
 
 // Instruction interpretation
 
+/**
+ * Moves iterator n positions forward without walking the rest of the container
+ * Cost is bound by the instruction argument, not by the text size
+ * @param it Iterator to move, it is left unchanged when the position is out of range
+ * @param end End of the container
+ * @param n Number of positions to move by
+ * @return true if the position exists and iterator was moved to it
+ */
+template<typename Iter>
+static bool advance_in_range(Iter &it, const Iter &end, int n) {
+    if(n < 0) {
+        return false;
+    }
+    auto target = it;
+    for(int i = 0; i < n && target != end; ++i) {
+        ++target;
+    }
+    if(target == end) {
+        return false;
+    }
+    it = target;
+    return true;
+}
+
 void CALL::exec(std::list<IR::Word *>::iterator &word, std::list<IR::Word *> *line, IR::PassEnvironment &env){
     // Words pass
     env.reprocess_obj = true;
@@ -129,12 +193,11 @@ void CONCAT::exec(std::list<IR::Word *>::iterator &word, std::list<IR::Word *> *
 void CONCAT::exec(std::list<std::list<IR::Word *> *>::iterator &line, 
                   std::list<std::list<IR::Word *> *> *doc, IR::PassEnvironment &env) {
     // Lines pass
-    if(std::distance(line, doc->end()) <= this->arg1){
+    auto src = line;
+    if(!advance_in_range(src, doc->end(), this->arg1)){
         LOG1("CONCAT argument in lines pass is out of range, skipping");
         return;
     }
-    auto src = line;
-    std::advance(src, this->arg1);
     (*line)->insert((*line)->end(), (*src)->begin(), (*src)->end());
     doc->erase(src);
     // Reprocess needed to work with the correct line next
@@ -143,7 +206,7 @@ void CONCAT::exec(std::list<std::list<IR::Word *> *>::iterator &line,
 
 void DEL::exec(std::list<IR::Word *>::iterator &word, std::list<IR::Word *> *line, IR::PassEnvironment &env){
     // Words pass
-    if((*word)->type == IR::EMPTY){
+    if((*word)->get_type() == IR::EMPTY){
         // Don't delete empty line
         return;
     }
@@ -197,24 +260,22 @@ void NOP::exec(std::list<std::list<IR::Word *> *>::iterator &line,
 void SWAP::exec(std::list<IR::Word *>::iterator &word, std::list<IR::Word *> *line, IR::PassEnvironment &env){
     // Words pass
     // Check if advanced iterator is correct otherwise dont do anything
-    if(std::distance(word, line->end()) <= this->arg1){
+    auto src = word;
+    if(!advance_in_range(word, line->end(), this->arg1)){
         LOG1("SWAP argument in words pass is out of range, skipping");
         return;
     }
-    auto src = word;
-    std::advance(word, this->arg1);
     std::iter_swap(src, word);
 }
 
 void SWAP::exec(std::list<std::list<IR::Word *> *>::iterator &line, 
                   std::list<std::list<IR::Word *> *> *doc, IR::PassEnvironment &env) {
     // Lines pass
-    if(std::distance(line, doc->end()) <= this->arg1){
+    auto src = line;
+    if(!advance_in_range(line, doc->end(), this->arg1)){
         LOG1("SWAP argument in lines pass is out of range, skipping");
         return;
     }
-    auto src = line;
-    std::advance(line, this->arg1);
     std::iter_swap(src, line);
 }
 
@@ -273,14 +334,9 @@ void MOVE::exec(Vars::SymbolTable *sym_table) {
         sym_table->copy(dst, isrc1);
     }
     else {
-        if(src1->type == IR::Type::NUMBER){
-            sym_table->set(dst, dynamic_cast<Vars::NumberVar*>(src1));
-        }
-        else if(src1->type == IR::Type::FLOAT) {
-            sym_table->set(dst, dynamic_cast<Vars::FloatVar*>(src1));
-        }
-        else if(src1->type == IR::Type::TEXT) {
-            sym_table->set(dst, dynamic_cast<Vars::TextVar*>(src1));
+        // Constant's value is copied into the register, since the constant is shared by program copies
+        if(src1->type == IR::Type::NUMBER || src1->type == IR::Type::FLOAT || src1->type == IR::Type::TEXT) {
+            sym_table->set(dst, src1);
         }
         else {
             throw Exception::EbeTypeException(std::string("Type '")+IR::get_type_name(src1->type)
@@ -26,11 +26,17 @@ namespace IR{
     struct PassEnvironment;
 }
 
+namespace Utils {
+    class BinaryWriter;
+}
+
 /** 
  * Namespace for instructions to not have class prefix 
  */
 namespace Inst {
 
+    class ExprKernel;
+
     /**
      * Abstract class for all instructions
      */
@@ -54,6 +60,13 @@ namespace Inst {
          */
         virtual void format_args(std::ostream &out);
 
+        /**
+         * Writes arguments into binary ebel file
+         * Arguments have to be written so that they can be passed to the instruction's constructor
+         * @param out Writer to write into
+         */
+        virtual void write_args([[maybe_unused]] Utils::BinaryWriter &out) {}
+
         /**
          * Instruction execution for PassWords
          * @param word Iterator pointing to the input word in a line
@@ -142,6 +155,13 @@ namespace Inst {
     public:
         virtual ~ExprInstruction() {}
 
+        /**
+         * Compiles the instruction into type specialized code
+         * @param kernel Compiled pass
+         * @return True if the instruction could be compiled
+         */
+        virtual bool compile([[maybe_unused]] ExprKernel &kernel) { return false; }
+
         void exec(std::list<IR::Word *>::iterator &word, std::list<IR::Word *> *line, 
                   IR::PassEnvironment &env) override {
             Error::error(Error::ErrorCode::INTERNAL, 
@@ -173,6 +193,8 @@ namespace Inst {
     public:
 
         void format_args(std::ostream &out) override;
+        void write_args(Utils::BinaryWriter &out) override;
+        bool compile(ExprKernel &kernel) override;
 
         ArithmeticInstruction(int dst, int isrc1, int isrc2, Vars::Variable *src1, Vars::Variable *src2) 
             : dst{dst}, isrc1{isrc1}, isrc2{isrc2}, src1{src1}, src2{src2} { control = false; }
@@ -230,6 +252,7 @@ namespace Inst {
         static const char * const NAME;
         const char * const get_name() override {return NAME;}
         inline void format_args(std::ostream &out) override;
+        void write_args(Utils::BinaryWriter &out) override;
         CALL(size_t arg1) : arg1{arg1} { control = true; }
         CALL *copy() const override {
             return new CALL(arg1);
@@ -246,6 +269,7 @@ namespace Inst {
         static const char * const NAME;
         const char * const get_name() override {return NAME;}
         inline void format_args(std::ostream &out) override;
+        void write_args(Utils::BinaryWriter &out) override;
         CONCAT(int arg1) : arg1{arg1} { control = false; }
         CONCAT *copy() const override {
             return new CONCAT(arg1);
@@ -316,6 +340,7 @@ namespace Inst {
         static const char * const NAME;
         const char * const get_name() override {return NAME;}
         inline void format_args(std::ostream &out) override;
+        void write_args(Utils::BinaryWriter &out) override;
         SWAP(int arg1) : arg1{arg1} { control = false; }
         SWAP *copy() const override {
             return new SWAP(arg1);
@@ -335,6 +360,8 @@ namespace Inst {
         static const char * const NAME;
         const char * const get_name() override { return NAME; }
         inline void format_args(std::ostream &out) override;
+        void write_args(Utils::BinaryWriter &out) override;
+        bool compile(ExprKernel &kernel) override;
         // For custom settings
         MOVE(int dst, int isrc1, Vars::Variable *src1) 
             : dst{dst}, isrc1{isrc1}, src1{src1} { control = true; }
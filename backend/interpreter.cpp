@@ -30,6 +30,38 @@ void Interpreter::parse(IR::Node *text) {
     }
 }
 
+bool Interpreter::is_line_local() {
+    for(auto pass: (*this->ebel->nodes)) {
+        if(pass->get_type() != IR::PassType::WORDS_PASS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Interpreter::start_lines() {
+    // Apply pragmas
+    this->ebel->pragmas->apply();
+    for(auto pass: (*this->ebel->nodes)) {
+        static_cast<IR::PassWords *>(pass)->reset();
+    }
+}
+
+bool Interpreter::is_block_parsable() {
+    for(auto pass: (*this->ebel->nodes)) {
+        if(static_cast<IR::PassWords *>(pass)->has_deferred()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Interpreter::parse_lines(const std::vector<std::list<IR::Word *> *> &lines, size_t line_number) {
+    for(auto pass: (*this->ebel->nodes)) {
+        static_cast<IR::PassWords *>(pass)->process(lines, line_number);
+    }
+}
+
 void Interpreter::eliminate_dead_code() {
     for(auto pass: (*this->ebel->nodes)) {
         if(pass->last_executed_index != -1 && pass->pipeline->size() != pass->last_executed_index) {
@@ -73,3 +105,42 @@ void Interpreter::optimize() {
     // Removing code that is not needed
     this->eliminate_redundat_code();
 }
+
+std::vector<IR::PassExpression *> Interpreter::get_expression_passes(std::vector<std::string> *names) {
+    std::vector<IR::PassExpression *> expr_passes;
+    size_t pass_number = 0;
+    for(auto pass: (*this->ebel->nodes)) {
+        ++pass_number;
+        if(pass->subpass_table == nullptr) {
+            continue;
+        }
+        for(size_t i = 0; i < pass->subpass_table->size(); ++i) {
+            auto subpass = (*pass->subpass_table)[i];
+            if(subpass->get_type() != IR::PassType::EXPRESSION_PASS) {
+                continue;
+            }
+            expr_passes.push_back(static_cast<IR::PassExpression *>(subpass));
+            if(names != nullptr) {
+                names->push_back("Expression subpass "+std::to_string(i+1)+" of pass "+std::to_string(pass_number));
+            }
+        }
+    }
+    return expr_passes;
+}
+
+void Interpreter::report_failures(const std::vector<Interpreter *> &interpreters, const char *file_name) {
+    std::vector<std::string> names;
+    auto expr_passes = interpreters[0]->get_expression_passes(&names);
+    // Other interpreters have copies of the same program, so their passes are at the same indices
+    std::vector<std::vector<IR::PassExpression *>> copies;
+    for(size_t i = 1; i < interpreters.size(); ++i) {
+        copies.push_back(interpreters[i]->get_expression_passes(nullptr));
+    }
+    for(size_t i = 0; i < expr_passes.size(); ++i) {
+        std::vector<IR::PassExpression *> pass_copies;
+        for(auto &c: copies) {
+            pass_copies.push_back(c[i]);
+        }
+        expr_passes[i]->report_failures(pass_copies, names[i], file_name);
+    }
+}
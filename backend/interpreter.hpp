@@ -12,6 +12,8 @@
 #ifndef _INTERPRETER_HPP_
 #define _INTERPRETER_HPP_
 
+#include <vector>
+#include <string>
 #include "ir.hpp"
 #include "compiler.hpp"
 
@@ -32,6 +34,12 @@ private:
      * Removes redundant code such as empty passes or loops where there's already other loop instructions
      */ 
     void eliminate_redundat_code();
+
+    /**
+     * @param names If not nullptr, description of each pass is added to it
+     * @return Expression subpasses of all passes in program order
+     */
+    std::vector<IR::PassExpression *> get_expression_passes(std::vector<std::string> *names);
 public:
     /**
      * Constructor
@@ -46,12 +54,50 @@ public:
      */
     void parse(IR::Node *text);
 
+    /**
+     * Checks if the text can be interpreted line by line using parse_lines
+     * This is possible only when all passes are words passes, since those do not
+     * depend on other lines
+     * @return true if program contains only words passes
+     */
+    bool is_line_local();
+
+    /**
+     * Prepares interpretation of a new text line by line
+     * @note Program has to be line local
+     */
+    void start_lines();
+
+    /**
+     * Checks if parsing blocks of lines is worth it
+     * @return true if program has expressions, which can be evaluated for blocks of lines at once
+     * @note start_lines has to be called before
+     */
+    bool is_block_parsable();
+
+    /**
+     * Parses block of lines of text using ebel code from initialization
+     * Each pass processes the whole block before the next one, so that expressions
+     * can be evaluated for many words at once
+     * @param lines Lines to be parsed
+     * @param line_number Number of the first line in the text
+     * @note start_lines has to be called before the first block
+     */
+    void parse_lines(const std::vector<std::list<IR::Word *> *> &lines, size_t line_number);
+
     /**
      * Uses analytics generated by parse method to optimize ebel code
      * @note This method requires parse to be run before it.
      * @note This modifies ebel member
      */ 
     void optimize();
+
+    /**
+     * Reports words expressions failed on during interpretation of a file
+     * @param interpreters Interpreters (of copies of the same program) used for the file
+     * @param file_name Name of the interpreted file
+     */
+    static void report_failures(const std::vector<Interpreter *> &interpreters, const char *file_name);
 };
 
 #endif//_INTERPRETER_HPP_
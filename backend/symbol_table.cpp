@@ -13,6 +13,7 @@
 #include "exceptions.hpp"
 #include "ir.hpp"
 #include "arg_parser.hpp"
+#include "utils.hpp"
 
 using namespace Vars;
 
@@ -33,47 +34,60 @@ std::string Variable::get_text() {
 
 
 SymbolTable::SymbolTable() : Compiler("Symbol table"), size{Args::arg_opts.sym_table_size} {
-    this->table = new Variable *[size]();
+    this->table = new Register[size];
 }
 
-SymbolTable::SymbolTable(IR::Word *var0) : Compiler("Symbol table"), size{Args::arg_opts.sym_table_size} {
-    this->table = new Variable *[size]();
-    if(var0->type == IR::Type::NUMBER) {
-        table[0] = new NumberVar(var0->to_int<IR::Type::NUMBER>());
-    }
-    else if(var0->type == IR::Type::FLOAT) {
-        table[0] = new FloatVar(var0->to_float<IR::Type::FLOAT>());
-    }
-    else if(var0->type == IR::Type::TEXT || var0->type == IR::Type::SYMBOL || var0->type == IR::Type::DELIMITER) {
-        table[0] = new TextVar(var0->to_string<IR::Type::TEXT>());
-    }
-
+SymbolTable::SymbolTable(IR::Word *var0) : SymbolTable() {
+    this->reset(var0);
 }
 
 SymbolTable::~SymbolTable() { 
     delete[] table;
 }
 
+IR::Type SymbolTable::var0_type(IR::Type word_type) {
+    if(word_type == IR::Type::NUMBER || word_type == IR::Type::FLOAT) {
+        return word_type;
+    }
+    if(word_type == IR::Type::TEXT || word_type == IR::Type::SYMBOL || word_type == IR::Type::DELIMITER) {
+        return IR::Type::TEXT;
+    }
+    return IR::Type::DERIVED;
+}
+
+void SymbolTable::reset(IR::Word *var0) {
+    // Text values are kept allocated, so that next word does not need to allocate them again
+    for(int i = 0; i < size; ++i) {
+        table[i].type = IR::Type::DERIVED;
+    }
+    table[0].type = var0_type(var0->get_type());
+    if(table[0].type == IR::Type::NUMBER) {
+        table[0].number = var0->to_int<IR::Type::NUMBER>();
+    }
+    else if(table[0].type == IR::Type::FLOAT) {
+        table[0].real = var0->to_float<IR::Type::FLOAT>();
+    }
+    else if(table[0].type == IR::Type::TEXT) {
+        table[0].text.assign(var0->get_text());
+    }
+}
+
 bool SymbolTable::assert_set(int index){
-    if(index >= size){
+    if(index < 0 || index >= size){
         throw Exception::EbeSymTableOutOfRangeException("Variable $"+std::to_string(index)
                 +" is out of range. Maximum allowed variable is $"+std::to_string(size-1));
         return false;
     }
-    // Remove previous possible value
-    if(table[index] != nullptr){
-        delete table[index];
-    }
     return true;
 }
 
 bool SymbolTable::assert_get(int index){
-    if(index >= size){
+    if(index < 0 || index >= size){
         throw Exception::EbeSymTableOutOfRangeException("Variable $"+std::to_string(index)
                 +" is out of range. Maximum allowed variable is $"+std::to_string(size-1));
         return false;
     }
-    if(table[index] == nullptr){
+    if(table[index].type == IR::Type::DERIVED){
         throw Exception::EbeSymTableUndefinedVarException("Attempt to access undefined variable $"+std::to_string(index));
         return false;
     }
@@ -82,7 +96,7 @@ bool SymbolTable::assert_get(int index){
 
 IR::Type SymbolTable::type_at(int index) {
     if(this->assert_get(index)){
-        return table[index]->type;
+        return table[index].type;
     }
     return IR::Type::DERIVED;
 }
@@ -95,37 +109,43 @@ void SymbolTable::set(int index, T value) {
 template<>
 void SymbolTable::set(int index, int value) {
     if(this->assert_set(index)){
-        table[index] = new NumberVar(value);
+        table[index].type = IR::Type::NUMBER;
+        table[index].number = value;
     }
 }
 
 template<>
 void SymbolTable::set(int index, float value) {
     if(this->assert_set(index)){
-        table[index] = new FloatVar(value);
+        table[index].type = IR::Type::FLOAT;
+        table[index].real = value;
     }
 }
 
 template<>
 void SymbolTable::set(int index, std::string value) {
     if(this->assert_set(index)){
-        table[index] = new TextVar(value);
+        table[index].type = IR::Type::TEXT;
+        table[index].text.assign(value);
     }
 }
 
-template<>
-void SymbolTable::set(int index, NumberVar *value) {
-    table[index] = value;
-}
-
-template<>
-void SymbolTable::set(int index, FloatVar *value) {
-    table[index] = value;
-}
-
-template<>
-void SymbolTable::set(int index, TextVar *value) {
-    table[index] = value;
+void SymbolTable::set(int index, Variable *value) {
+    if(value->type == IR::Type::NUMBER) {
+        this->set<int>(index, value->get_number());
+    }
+    else if(value->type == IR::Type::FLOAT) {
+        this->set<float>(index, value->get_float());
+    }
+    else if(value->type == IR::Type::TEXT) {
+        if(this->assert_set(index)) {
+            table[index].type = IR::Type::TEXT;
+            table[index].text.assign(static_cast<TextVar *>(value)->value);
+        }
+    }
+    else {
+        throw Exception::EbeSymTableUnknwonTypeException("Attempt to set variable to not supported type");
+    }
 }
 
 template<typename T>
@@ -137,7 +157,10 @@ T SymbolTable::get(int index) {
 template<>
 int SymbolTable::get(int index) {
     if(this->assert_get(index)){
-        return table[index]->get_number();
+        if(table[index].type != IR::Type::NUMBER) {
+            throw Exception::EbeSymTableTypeException("Attempt to extract NUMBER from variable of different type");
+        }
+        return table[index].number;
     }
     return 0;
 }
@@ -145,7 +168,10 @@ int SymbolTable::get(int index) {
 template<>
 float SymbolTable::get(int index) {
     if(this->assert_get(index)){
-        return table[index]->get_float();
+        if(table[index].type != IR::Type::FLOAT) {
+            throw Exception::EbeSymTableTypeException("Attempt to extract FLOAT from variable of different type");
+        }
+        return table[index].real;
     }
     return 0.0f;
 }
@@ -153,7 +179,10 @@ float SymbolTable::get(int index) {
 template<>
 std::string SymbolTable::get(int index) {
     if(this->assert_get(index)){
-        return table[index]->get_text();
+        if(table[index].type != IR::Type::TEXT) {
+            throw Exception::EbeSymTableTypeException("Attempt to extract TEXT from variable of different type");
+        }
+        return table[index].text;
     }
     return "";
 }
@@ -161,23 +190,35 @@ std::string SymbolTable::get(int index) {
 void SymbolTable::copy(int dst, int src) {
     assert_set(dst);
     assert_get(src);
-    table[dst] = table[src]->clone();
+    if(dst == src) {
+        return;
+    }
+    table[dst].type = table[src].type;
+    if(table[src].type == IR::Type::TEXT) {
+        table[dst].text.assign(table[src].text);
+    }
+    else if(table[src].type == IR::Type::NUMBER) {
+        table[dst].number = table[src].number;
+    }
+    else {
+        table[dst].real = table[src].real;
+    }
 }
 
-std::string SymbolTable::to_string(int index) {
-    if(index >= size) { 
+std::string_view SymbolTable::to_string(int index) {
+    if(index < 0 || index >= size) { 
         throw Exception::EbeSymTableOutOfRangeException("Variable $"+std::to_string(index)
             +" is out of range. Maximum allowed variable is $"+std::to_string(size-1));
     }
-    auto var = table[index];
-    if(var->type == IR::Type::NUMBER) {
-        return std::to_string(var->get_number());
+    auto &var = table[index];
+    if(var.type == IR::Type::NUMBER) {
+        return Cast::format(var.number, format_buffer);
     }
-    if(var->type == IR::Type::FLOAT) {
-        return std::to_string(var->get_float());
+    if(var.type == IR::Type::FLOAT) {
+        return Cast::format(var.real, format_buffer);
     }
-    if(var->type == IR::Type::TEXT) {
-        return var->get_text();
+    if(var.type == IR::Type::TEXT) {
+        return var.text;
     }
     throw Exception::EbeSymTableTypeException("Variable $"+std::to_string(index)+" type could not be casted to a string");
 }
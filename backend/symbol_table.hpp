@@ -13,8 +13,11 @@
 #define _SYMBOL_TABLE_HPP_
 
 #include <string>
+#include <string_view>
 #include "compiler.hpp"
+#include "binary.hpp"
 #include "ir.hpp"
+#include "utils.hpp"
 
 /**
  * Namespace for working with variables
@@ -62,6 +65,21 @@ namespace Vars {
          * @param out Output stream to print into
          */ 
         virtual void format_value(std::ostream &out) { out << "$(VALUE)"; }
+
+        /**
+         * Writes value in the variable into binary ebel file
+         * @param out Writer to write into
+         */ 
+        virtual void write_value([[maybe_unused]] Utils::BinaryWriter &out) {}
+
+        /**
+         * Writes type and value of the variable into binary ebel file
+         * @param out Writer to write into
+         */ 
+        void write(Utils::BinaryWriter &out) {
+            out.write_u8(static_cast<uint8_t>(type));
+            write_value(out);
+        }
     };
 
     /**
@@ -81,6 +99,7 @@ namespace Vars {
         int get_number() override { return value; }
 
         void format_value(std::ostream &out) override { out << value; };
+        void write_value(Utils::BinaryWriter &out) override { out.write_i32(value); }
     };
 
     /**
@@ -100,6 +119,7 @@ namespace Vars {
         float get_float() override { return value; }
 
         void format_value(std::ostream &out) override { out << value; };
+        void write_value(Utils::BinaryWriter &out) override { out.write_float(value); }
     };
 
     /**
@@ -108,6 +128,7 @@ namespace Vars {
     class TextVar : public Variable {
     private:
         std::string value;
+        friend class SymbolTable;
     public:
         /**
          * Constructor
@@ -119,19 +140,38 @@ namespace Vars {
         std::string get_text() override { return value; }
 
         void format_value(std::ostream &out) override { out << "\"" << value << "\""; };
+        void write_value(Utils::BinaryWriter &out) override { out.write_string(value); }
+    };
+
+    /**
+     * Symbol table register holding value of one variable
+     * Tagged union, so NUMBER and FLOAT values do not need any allocation
+     * and TEXT value reuses string's memory when it is overwritten.
+     */
+    struct Register {
+        IR::Type type;     ///< Type of the value, IR::Type::DERIVED when the variable is undefined
+        union {
+            int number;    ///< NUMBER value
+            float real;    ///< FLOAT value
+        };
+        std::string text;  ///< TEXT value
+
+        Register() : type{IR::Type::DERIVED}, number{0}, text{} {}
     };
 
     /**
      * Symbol table is used to hold values of variables in currently interpreted expressions.
+     * Table is allocated once (for each expression pass) and reset for every word.
      * @note Index 0 is the $ variable (user input).
      */ 
     class SymbolTable : public Compiler {
     private:
         int size;                        ///< Size of symbol table
-        Variable **table;                ///< Symbol table itself
+        Register *table;                 ///< Symbol table itself
+        char format_buffer[Cast::FORMAT_BUFFER_SIZE];  ///< Buffer for to_string of numbers
     
         /**
-         * Does all needed asserts for set methods and deletes possible previous value
+         * Does all needed asserts for set methods
          * @param index Index of set variable
          * @return True if all succeeded
          */ 
@@ -160,6 +200,24 @@ namespace Vars {
          */ 
         ~SymbolTable();
 
+        SymbolTable(const SymbolTable &other) = delete;
+        SymbolTable &operator=(const SymbolTable &other) = delete;
+
+        /**
+         * @param word_type Type of a word
+         * @return Type of $0 set from a word of this type (DERIVED if $0 is left undefined)
+         */
+        static IR::Type var0_type(IR::Type word_type);
+
+        /**
+         * Undefines all variables and sets $0
+         * @param var0 $0 in a form of IR::Word
+         */ 
+        void reset(IR::Word *var0);
+
+        /** @return Size of the symbol table */
+        int get_size() const { return size; }
+
         /**
          * Sets variable $index to value in symbol table
          * @param index Variable's index
@@ -170,6 +228,14 @@ namespace Vars {
         template<typename T>
         void set(int index, T value);
 
+        /**
+         * Sets variable $index to a value of a constant
+         * @param index Variable's index
+         * @param value Constant which value is copied (table does not take its ownership)
+         * @throw EbeSymTableOutOfRangeException when index >= SIZE
+         */
+        void set(int index, Variable *value);
+
         /**
          * Gets value of $index variable in symbol table
          * @param index Variable's index
@@ -198,9 +264,9 @@ namespace Vars {
         /**
          * Parses value to a string
          * @param index Variable's index
-         * @return Variable's value as a string (to save into word)
+         * @return Variable's value as a string (to save into word), valid until the table is modified
          */ 
-        std::string to_string(int index);
+        std::string_view to_string(int index);
     };
 }
 
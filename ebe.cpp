@@ -15,10 +15,18 @@
 #include <vector>
 #include <iomanip>
 #include <filesystem>
+#include <sstream>
+#include <cstdio>
+#include <cerrno>
+#include <mutex>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
 #include "ebe.hpp"
 #include "preprocessor.hpp"
 #include "scanner_text.hpp"
 #include "scanner_ebel.hpp"
+#include "ebel_binary.hpp"
 #include "ir.hpp"
 #include "interpreter.hpp"
 #include "engine_jenn.hpp"
@@ -27,6 +35,25 @@
 #include "rng.hpp"
 #include "logging.hpp"
 #include "arg_parser.hpp"
+#include "workers.hpp"
+#include "utils.hpp"
+
+/**
+ * Saves ebel program into a file
+ * Files with .ebelc extension are saved in binary format, other as ebel code
+ * @param ebel Program to save
+ * @param file_name Path to the file
+ */
+void save_ebel(IR::EbelNode *ebel, const std::string &file_name) {
+    if(EbelFile::is_binary_name(file_name)) {
+        std::ofstream o_file(file_name, std::ios::binary);
+        EbelFile::save_binary(ebel, o_file);
+    }
+    else {
+        std::ofstream o_file(file_name);
+        o_file << *ebel;
+    }
+}
 
 /**
  * Initializer and handler for compilation
@@ -156,9 +183,7 @@ void compile(const char *f_in, const char *f_out) {
         }
 
         // Folder existence is checked in arg_parser
-        std::ofstream o_file(ebel_out);
-        o_file << *ebel;
-        o_file.close(); 
+        save_ebel(ebel, ebel_out);
 
         if(!Args::arg_opts.no_info_print) {
             std::cout << "Ebel saved to '" << ebel_out << "'." << std::endl;
@@ -185,27 +210,229 @@ void compile(const char *f_in, const char *f_out) {
     LOGMAX("Compilation done");
 }
 
-void interpret_core(IR::EbelNode *ebel, std::vector<const char *> input_files) {
-    // Interpret initialization
-    auto interpreter = new Interpreter(ebel);
+/** Amount of lines interpreted at once when interpreting line by line */
+const size_t LINE_BLOCK_SIZE = 512;
 
-    bool use_stdin = false;
-    // If no input files are specified, use stdin
-    if(input_files.empty()) {
-        input_files.push_back("stdin");
-        use_stdin = true;
+/**
+ * Interprets block of lines and writes them out
+ * @param interpreter Interpreter of line local program
+ * @param lines Lines to interpret, they are deleted and the block is cleared afterwards
+ * @param line_number Number of the first line, increased by the amount of lines
+ * @param output Output stream or string
+ */
+template<typename T>
+void interpret_block(Interpreter *interpreter, std::vector<std::list<IR::Word *> *> &lines, size_t &line_number, T &output) {
+    interpreter->parse_lines(lines, line_number);
+    line_number += lines.size();
+    for(auto line: lines) {
+        for(auto word: *line){
+            output += word->get_text();
+            delete word;
+        }
+        output += Args::arg_opts.line_delim;
+        delete line;
+    }
+    lines.clear();
+}
+
+/**
+ * Output stream adaptor for interpret_block
+ */
+struct StreamOutput {
+    std::ostream &out;  ///< Output stream
+    template<typename T>
+    StreamOutput &operator+=(const T &text) {
+        out << text;
+        return *this;
+    }
+};
+
+/**
+ * Interprets text line by line in chunks split on line ends, which are interpreted in parallel
+ * @param interpreters Interpreter for every worker, program has to be line local
+ * @param text Input text
+ * @param input_f Input file name
+ * @param out Output stream
+ */
+void interpret_chunks(const std::vector<Interpreter *> &interpreters, std::istream *text, const char *input_f, std::ostream &out) {
+    const size_t CHUNK_SIZE = 4 * 1024 * 1024;
+    auto &workers = WorkerPool::get();
+    std::vector<std::string> chunks(interpreters.size());
+    std::vector<std::string> outputs(interpreters.size());
+    std::vector<size_t> first_line(interpreters.size());
+    // Part of the last line read after the last line end
+    std::string rest;
+    size_t line_number = 0;
+    bool eof = false;
+    while(!eof) {
+        // Read chunk for each worker
+        size_t count = 0;
+        while(count < chunks.size() && !eof) {
+            auto &chunk = chunks[count];
+            chunk.swap(rest);
+            rest.clear();
+            size_t start = chunk.size();
+            chunk.resize(start + CHUNK_SIZE);
+            text->read(&chunk[start], CHUNK_SIZE);
+            chunk.resize(start + text->gcount());
+            if(!*text) {
+                eof = true;
+            }
+            else {
+                auto last_nl = chunk.rfind('\n');
+                if(last_nl == std::string::npos) {
+                    // Line is longer than the chunk, read more
+                    chunk.swap(rest);
+                    continue;
+                }
+                rest.assign(chunk, last_nl+1, std::string::npos);
+                chunk.resize(last_nl+1);
+            }
+            first_line[count] = line_number;
+            line_number += std::count(chunk.begin(), chunk.end(), '\n');
+            ++count;
+        }
+        workers.run(count, [&](size_t worker, size_t i) {
+            auto interpreter = interpreters[worker];
+            auto &output = outputs[i];
+            output.clear();
+            Utils::MemoryBuffer buffer(chunks[i].data(), chunks[i].size());
+            std::istream chunk_stream(&buffer);
+            size_t chunk_line = first_line[i];
+            TextFile::ScannerText text_scanner;
+            std::vector<std::list<IR::Word *> *> block;
+            interpreter->start_lines();
+            const size_t block_size = interpreter->is_block_parsable() ? LINE_BLOCK_SIZE : 1;
+            text_scanner.process(&chunk_stream, input_f, [&](std::list<IR::Word *> *line) {
+                block.push_back(line);
+                if(block.size() == block_size) {
+                    interpret_block(interpreter, block, chunk_line, output);
+                }
+            });
+            interpret_block(interpreter, block, chunk_line, output);
+        });
+        for(size_t i = 0; i < count; ++i) {
+            out << outputs[i];
+        }
+    }
+}
+
+/**
+ * Opens (creates or truncates) output file
+ * @param file_name Path to the file
+ * @return Buffer writing into the file
+ */
+Utils::FdOutputBuffer *open_output(const std::string &file_name) {
+    int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if(fd < 0) {
+        Error::error(Error::ErrorCode::FILE_ACCESS, ("Could not open output file "+file_name).c_str());
+    }
+    return new Utils::FdOutputBuffer(fd, true);
+}
+
+/**
+ * Copies whole content of a file into stream
+ * @param file File to copy from its start
+ * @param out Output stream
+ */
+void copy_output(FILE *file, std::ostream &out) {
+    const size_t BLOCK_SIZE = 1024*1024;
+    std::vector<char> block(BLOCK_SIZE);
+    int fd = fileno(file);
+    off_t offset = 0;
+    ssize_t read;
+    while((read = pread(fd, block.data(), BLOCK_SIZE, offset)) != 0) {
+        if(read < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            Error::error(Error::ErrorCode::FILE_ACCESS, "Could not read temporary output file");
+        }
+        out.write(block.data(), read);
+        offset += read;
+    }
+}
+
+/**
+ * Interprets one input file
+ * @param interpreters Interpreters to be used, when there is more than one (one for each worker)
+ *                     line local programs are interpreted in parallel
+ * @param input_f Input file name
+ * @param use_stdin If true, standard input is interpreted instead of input_f
+ * @param multiple True if more than one file is interpreted
+ * @param std_out Output stream used when no output file was set
+ */
+void interpret_file(const std::vector<Interpreter *> &interpreters, const char *input_f, bool use_stdin, 
+                    bool multiple, std::ostream &std_out) {
+    auto interpreter = interpreters[0];
+    // Preprocessing input file
+    auto text_preproc = new Preprocessor();
+    LOGMAX("Text preprocessor for " << input_f << " started");
+    auto text_stream = text_preproc->process(use_stdin ? nullptr : input_f);
+    LOGMAX("Text preprocessor finished");
+
+    // Output stream
+    std::ostream *out = &std_out;
+    std::ostream o_file(nullptr);
+    Utils::FdOutputBuffer *o_buffer = nullptr;
+    std::string f_out_name;
+    // Programs with only words passes can be interpreted and output line by line
+    bool stream_lines = interpreter->is_line_local();
+    if(Args::arg_opts.interpret_out == nullptr) { 
+        if(multiple) {
+            std_out << "# Interpreted " << input_f << ": " << std::endl;
+        }
+    }
+    else {
+        // Folder existence is checked in arg_parser
+        f_out_name = std::string(Args::arg_opts.interpret_out);
+        if(multiple) {
+            auto file_name = std::filesystem::path(input_f);
+            // Create file name if multiple files are interpreted
+            f_out_name = std::string(Args::arg_opts.interpret_out) + "/edited-" + std::string(file_name.filename());
+        }
+        std::error_code ec;
+        if(!use_stdin && std::filesystem::equivalent(input_f, f_out_name, ec)) {
+            // Output file would be overwritten before it is read
+            stream_lines = false;
+        }
+        out = &o_file;
     }
-    for(auto input_f: input_files){
-        // Preprocessing input file
-        auto text_preproc = new Preprocessor();
-        LOGMAX("Text preprocessor for " << input_f << " started");
-        auto text_stream = text_preproc->process(use_stdin ? nullptr : input_f);
-        LOGMAX("Text preprocessor finished");
 
-        // Syntactical check/parse of input file
-        auto text_scanner = new TextFile::ScannerText();
+    // Syntactical check/parse of input file
+    auto text_scanner = new TextFile::ScannerText();
+    if(stream_lines) {
+        LOGMAX("Line by line interpretation started");
+        if(!f_out_name.empty()) {
+            o_buffer = open_output(f_out_name);
+            o_file.rdbuf(o_buffer);
+        }
+        // Terminal input is interpreted as soon as each line is entered, so it is not read in chunks
+        const bool interactive = use_stdin && isatty(STDIN_FILENO);
+        if(interpreters.size() > 1 && !interactive) {
+            interpret_chunks(interpreters, text_stream, input_f, *out);
+        }
+        else {
+            StreamOutput output{*out};
+            std::vector<std::list<IR::Word *> *> block;
+            size_t line_number = 0;
+            interpreter->start_lines();
+            const size_t block_size = interpreter->is_block_parsable() && !interactive ? LINE_BLOCK_SIZE : 1;
+            text_scanner->process(text_stream, input_f, [&](std::list<IR::Word *> *line) {
+                block.push_back(line);
+                if(block.size() == block_size) {
+                    interpret_block(interpreter, block, line_number, output);
+                }
+            });
+            interpret_block(interpreter, block, line_number, output);
+        }
+        LOGMAX("Line by line interpretation finished");
+    }
+    else {
         LOGMAX("Text scanner started");
-        auto text_ir = text_scanner->process(text_stream, input_f);
+        // More interpreters are passed only outside of worker tasks, so text can be scanned in parallel
+        auto text_ir = interpreters.size() > 1 ? text_scanner->process(text_stream, input_f, WorkerPool::get())
+                                               : text_scanner->process(text_stream, input_f);
         LOG1("Text IR:\n" << *text_ir);
         LOGMAX("Text scanner finished");
 
@@ -214,54 +441,144 @@ void interpret_core(IR::EbelNode *ebel, std::vector<const char *> input_files) {
         LOGMAX("Interpreter finished");
         LOG1("Interpreted text IR:\n" << *text_ir);
 
-        if(Args::arg_opts.interpret_out == nullptr) { 
-            if(input_files.size() > 1) {
-                std::cout << "# Interpreted " << input_f << ": " << std::endl;
-            }
-            std::cout << text_ir->output();
-        }
-        else {
-            // Folder existence is checked in arg_parser
-            auto f_out_name = std::string(Args::arg_opts.interpret_out);
-            if(input_files.size() > 1) {
-                auto file_name = std::filesystem::path(input_f);
-                // Create file name if multiple files are interpreted
-                f_out_name = std::string(Args::arg_opts.interpret_out) + "/edited-" + std::string(file_name.filename());
-            }
-            std::ofstream o_file(f_out_name);
-            o_file << text_ir->output();
-            o_file.close();
+        if(!f_out_name.empty()) {
+            o_buffer = open_output(f_out_name);
+            o_file.rdbuf(o_buffer);
         }
-
+        text_ir->output(*out);
         delete text_ir;
-        delete text_scanner;
-        if(!use_stdin) {
-            delete text_stream;
+    }
+    // Flushes and closes the output file
+    delete o_buffer;
+    // Words expressions failed on are reported once for the whole file
+    Interpreter::report_failures(interpreters, input_f);
+
+    delete text_scanner;
+    if(!use_stdin) {
+        delete text_stream;
+    }
+    delete text_preproc;
+}
+
+void interpret_core(IR::EbelNode *ebel, std::vector<const char *> input_files) {
+    bool use_stdin = false;
+    // If no input files are specified, use stdin
+    if(input_files.empty()) {
+        input_files.push_back("stdin");
+        use_stdin = true;
+    }
+    bool multiple = input_files.size() > 1;
+
+    // Interpret initialization
+    // Passes hold interpretation state, so every worker needs its own copy of the program.
+    // Pragmas are applied before, so that workers only read the options set by them
+    auto &workers = WorkerPool::get();
+    ebel->pragmas->apply();
+    std::vector<IR::EbelNode *> ebels{ebel};
+    for(size_t i = 1; i < workers.size(); ++i) {
+        ebels.push_back(new IR::EbelNode(*ebel));
+    }
+    std::vector<Interpreter *> interpreters;
+    for(auto e: ebels) {
+        interpreters.push_back(new Interpreter(e));
+    }
+
+    // Standard output is written directly into its file descriptor
+    // (static, so that the output is flushed even when an error exits the program)
+    std::cout.flush();
+    static Utils::FdOutputBuffer stdout_buffer(STDOUT_FILENO);
+    std::ostream stdout_stream(&stdout_buffer);
+    if(workers.size() < 2) {
+        // Errors have to be printed after the output preceding them (as with std::cout)
+        std::cerr.tie(&stdout_stream);
+    }
+    if(workers.size() < 2 || !multiple) {
+        // Single file can still be interpreted in parallel in chunks
+        for(auto input_f: input_files){
+            interpret_file(interpreters, input_f, use_stdin, multiple, stdout_stream);
+            // Words of the file are gone, peak memory does not have to be kept for the next one
+            IR::Word::release_pools();
         }
-        delete text_preproc;
     }
-    if(use_stdin) {
-        input_files.pop_back();
+    else {
+        // Parallel interpretation of files
+        // Standard output is printed in the order of input files. File whose turn it is
+        // writes into it directly, others are written into temporary files and copied once
+        // all preceding files are finished.
+        std::vector<FILE *> outputs(input_files.size(), nullptr);
+        std::vector<bool> finished(input_files.size(), false);
+        size_t next_output = 0;
+        std::mutex output_lock;
+        workers.run(input_files.size(), [&](size_t worker, size_t i) {
+            bool direct;
+            {
+                std::lock_guard<std::mutex> guard(output_lock);
+                // Following files are not printed until this one is finished
+                direct = next_output == i;
+            }
+            if(direct) {
+                interpret_file({interpreters[worker]}, input_files[i], false, true, stdout_stream);
+            }
+            else {
+                outputs[i] = std::tmpfile();
+                if(outputs[i] == nullptr) {
+                    Error::error(Error::ErrorCode::FILE_ACCESS, "Could not create temporary output file");
+                }
+                Utils::FdOutputBuffer buffer(fileno(outputs[i]));
+                std::ostream std_out(&buffer);
+                interpret_file({interpreters[worker]}, input_files[i], false, true, std_out);
+            }
+            std::lock_guard<std::mutex> guard(output_lock);
+            finished[i] = true;
+            while(next_output < outputs.size() && finished[next_output]) {
+                if(outputs[next_output] != nullptr) {
+                    copy_output(outputs[next_output], stdout_stream);
+                    std::fclose(outputs[next_output]);
+                }
+                ++next_output;
+            }
+        });
+        IR::Word::release_pools();
+    }
+    stdout_stream.flush();
+    std::cerr.tie(&std::cout);
+    for(auto i: interpreters) {
+        delete i;
+    }
+    for(size_t i = 1; i < ebels.size(); ++i) {
+        delete ebels[i];
     }
-    delete interpreter;
 }
 
 void interpret(const char *ebel_f, std::vector<const char *> input_files){
     LOGMAX("Interpetation started");    
-    // Preprocessing
-    auto ebel_preproc = new Preprocessor();
-    LOGMAX("Ebel preprocessor started");
-    auto ebel_text = ebel_preproc->process(ebel_f);
-    LOGMAX("Ebel preprocessor finished");
-
-    // Syntactical check
-    auto ebel_scanner = new EbelFile::ScannerEbel();
-    LOGMAX("Ebel scanner started");
-    auto ebel_ir = ebel_scanner->process(ebel_text, ebel_f);
+    // Precompiled ebel does not need to be parsed
+    auto ebel_ir = EbelFile::load_binary(ebel_f);
+    Preprocessor *ebel_preproc = nullptr;
+    std::istream *ebel_text = nullptr;
+    EbelFile::ScannerEbel *ebel_scanner = nullptr;
+    if(ebel_ir == nullptr) {
+        // Preprocessing
+        ebel_preproc = new Preprocessor();
+        LOGMAX("Ebel preprocessor started");
+        ebel_text = ebel_preproc->process(ebel_f);
+        LOGMAX("Ebel preprocessor finished");
+
+        // Syntactical check
+        ebel_scanner = new EbelFile::ScannerEbel();
+        LOGMAX("Ebel scanner started");
+        ebel_ir = ebel_scanner->process(ebel_text, ebel_f);
+        LOGMAX("Ebel scanner finished");
+    }
     LOG1("Ebel IR:\n" << *ebel_ir);
-    LOGMAX("Ebel scanner finished");
 
-    interpret_core(ebel_ir, input_files);
+    if(Args::arg_opts.ebel_out) {
+        // Ebel can be converted (precompiled), then only files passed are interpreted
+        save_ebel(ebel_ir, Args::arg_opts.ebel_out);
+    }
+    if(!Args::arg_opts.ebel_out || !input_files.empty()) {
+        interpret_core(ebel_ir, input_files);
+    }
 
     // Cleanup
     delete ebel_ir;
@@ -308,9 +625,7 @@ void compile_and_interpret(const char *f_in, const char *f_out, std::vector<cons
         std::string ebel_out = std::string(Args::arg_opts.ebel_out);
 
         // Folder existence is checked in arg_parser
-        std::ofstream o_file(ebel_out);
-        o_file << *ebel;
-        o_file.close(); 
+        save_ebel(ebel, ebel_out);
 
         // Don't print if output will go to stdcout
         if(!Args::arg_opts.no_info_print) {
@@ -16,13 +16,17 @@
 #include <unordered_set>
 #include <vector>
 #include <utility>
+#include <atomic>
 #include "engine.hpp"
 #include "ir.hpp"
+#include "document.hpp"
 #include "compiler.hpp"
 #include "interpreter.hpp"
 #include "rng.hpp"
 #include "logging.hpp"
 #include "arg_parser.hpp"
+#include "workers.hpp"
+#include "fitness.hpp"
 
 #include <iostream>
 
@@ -199,15 +203,24 @@ Engine::Engine(IR::Node *text_in, IR::Node *text_out, size_t iterations, EngineU
                                                                                                             text_out(text_out),
                                                                                                             iterations(iterations) {
     this->engine_name = EngineUtils::get_engine_name(this->engine_id);
+    this->target = new Fitness::Target(text_out, Args::arg_opts.fit_fun);
 }
 
-float Engine::compare(IR::Node *ir1, IR::Node *ir2){
-    return Args::arg_opts.fit_fun(ir1, ir2);
+Engine::~Engine() {
+    delete target;
+}
+
+float Engine::compare(IR::Node *text){
+    return target->compare(text);
 }
 
 GPEngine::~GPEngine() {
     delete params;
     delete population;
+    for(auto text: scratch) {
+        delete text;
+    }
+    delete text_in_doc;
     // Don't delete expression pass
 }
 
@@ -318,6 +331,11 @@ void GPEngine::crossover_switch(GP::Phenotype *pheno) {
 
 GPEngine::GPEngine(IR::Node *text_in, IR::Node *text_out, size_t iterations, EngineUtils::EngineID engine_id) : 
                    Engine(text_in, text_out, iterations, engine_id), expr_pass{nullptr} {
+    // Evaluation copies of input text for each worker
+    text_in_doc = new IR::Document(*text_in);
+    for(size_t i = 0; i < WorkerPool::get().size(); ++i) {
+        scratch.push_back(new IR::Node(*text_in));
+    }
     // Checking input text if it contains expression to do those first
     if(Args::arg_opts.expr){
         bool contains_expr = false;
@@ -328,15 +346,15 @@ GPEngine::GPEngine(IR::Node *text_in, IR::Node *text_out, size_t iterations, Eng
         if(line1 != (text_out->nodes)->end()){
             int index = 0;
             for(auto word: **line1) {
-                if(word->type == IR::Type::EXPRESSION) {
-                    if(word->code != nullptr && word->return_inst != nullptr) {
-                        w_pass->push_subpass(word->code);
-                        w_pass->push_back(word->return_inst);
+                if(word->get_type() == IR::Type::EXPRESSION) {
+                    if(word->get_code() != nullptr && word->get_return_inst() != nullptr) {
+                        w_pass->push_subpass(word->get_code());
+                        w_pass->push_back(word->get_return_inst());
                         contains_expr = true;
                     }
                     else {
                         Error::error(Error::ErrorCode::INTERNAL, std::string("Somehow expression code was not"
-                        " generated for '"+word->text).c_str());
+                        " generated for '"+word->get_text()).c_str());
                     }
                 }
                 else {
@@ -351,27 +369,50 @@ GPEngine::GPEngine(IR::Node *text_in, IR::Node *text_out, size_t iterations, Eng
     }
 }
 
+float GPEngine::evaluate(GP::Phenotype *pheno, IR::Node *text, bool run_time_optimize) {
+    // Set the evaluation copy back to the input text
+    text->reset(*this->text_in_doc);
+    Interpreter interpreter(pheno->program);
+    interpreter.parse(text);
+    if(run_time_optimize) {
+        // Run optimizations
+        interpreter.optimize();
+    }
+    float fit = compare(text);
+    // Set the fitness
+    pheno->fitness = fit;
+    return fit;
+}
+
 GP::Phenotype *GPEngine::evaluate(bool run_time_optimize) {
-    GP::Phenotype *perfect_program = nullptr;
-    for(auto &pheno: *this->population->candidates){
-        // If expression is set then insert it at the begining
-        auto interpreter = new Interpreter(pheno->program);
-        IR::Node *text_copy = new IR::Node(*this->text_in);
-        interpreter->parse(text_copy);
-        if(run_time_optimize) {
-            // Run optimizations
-            interpreter->optimize();
+    auto &workers = WorkerPool::get();
+    if(workers.size() < 2) {
+        for(auto &pheno: *this->population->candidates){
+            if(evaluate(pheno, scratch[0], run_time_optimize) >= 1.0f){
+                // Program which does what it's supposed to do
+                return pheno;
+            }
+        }
+        return nullptr;
+    }
+
+    // Parallel evaluation
+    std::vector<GP::Phenotype *> candidates(this->population->candidates->begin(), 
+                                            this->population->candidates->end());
+    // Index of the first perfect phenotype, so that the result is the same as for serial evaluation
+    std::atomic<size_t> perfect_index{candidates.size()};
+    workers.run(candidates.size(), [&](size_t worker, size_t i) {
+        // Serial evaluation would end before this phenotype
+        if(i > perfect_index) {
+            return;
         }
-        float fit = compare(text_out, text_copy);
-        // Set the fitness
-        pheno->fitness = fit;
-        if(fit >= 1.0f){
-            // Program which does what it's supposed to do
-            perfect_program = pheno;
-            break;
+        if(evaluate(candidates[i], scratch[worker], run_time_optimize) >= 1.0f) {
+            size_t current = perfect_index;
+            while(i < current && !perfect_index.compare_exchange_weak(current, i));
         }
-        delete text_copy;
-        delete interpreter;
+    });
+    if(perfect_index < candidates.size()) {
+        return candidates[perfect_index];
     }
-    return perfect_program;
+    return nullptr;
 }
@@ -26,10 +26,14 @@ namespace GP {
 }
 namespace IR {
     class Node;
+    class Document;
     class EbelNode;
     class PassWords;
     enum PassType: int;
 }
+namespace Fitness {
+    class Target;
+}
 
 /**
  * Namespace containing utilities used by the compiler that 
@@ -81,6 +85,7 @@ protected:
     IR::Node *text_in;        ///< IR of input example text
     IR::Node *text_out;       ///< IR of output example text
     size_t iterations;        ///< How many iterations should be done
+    Fitness::Target *target;  ///< Output example text prepared for fitness calculation
     
     /**
      * Constructor
@@ -92,15 +97,14 @@ protected:
     Engine(IR::Node *text_in, IR::Node *text_out, size_t iterations, EngineUtils::EngineID engine_id);
 
     /**
-     * Compares 2 text IRs and returns percentage-wise similarity.
-     * @param ir1 First IR to compare
-     * @param ir2 Second IR to comapre
-     * @return How much are ir1 and ir2 similar as a percentage (0-1)
+     * Compares text IR with the output example and returns percentage-wise similarity.
+     * @param text IR to compare
+     * @return How much are text and text_out similar as a percentage (0-1)
      */ 
-    float compare(IR::Node *ir1, IR::Node *ir2);
+    float compare(IR::Node *text);
 public:
     /** Destructor */
-    virtual ~Engine() {}
+    virtual ~Engine();
 
     /**
      * Through evolution and set params generated new ebel program for input and output passed in at creation
@@ -170,6 +174,12 @@ protected:
     GPEngineParams *params;
     GP::Population *population;
     IR::PassWords *expr_pass = nullptr;
+    /**
+     * Evaluation copies of text_in, one for each worker.
+     * These are reset to text_in before each evaluation instead of being copied.
+     */
+    std::vector<IR::Node *> scratch;
+    IR::Document *text_in_doc;  ///< text_in in contiguous form, scratch copies are reset from it
 
     /**
      * Constructor
@@ -183,11 +193,23 @@ protected:
 
     /**
      * Evaluates all the candidates and saves their fitness to fitness list
+     * When more than 1 job is set, then candidates are evaluated in parallel by the worker pool
      * @param run_time_optimize If true interpreter optimizations are run over each phenotype
      * @return Returns a node with 1.0f if present otherwise nullptr
+     * @note When multiple phenotypes have 1.0f fitness the first one in population is returned
      */ 
     GP::Phenotype *evaluate(bool run_time_optimize=false);
 
+    /**
+     * Evaluates one phenotype and saves its fitness
+     * @param pheno Phenotype to evaluate
+     * @param text Worker's evaluation copy of text_in, it will be reset to text_in
+     * @param run_time_optimize If true interpreter optimizations are run over the phenotype
+     * @return Phenotype's fitness
+     * @note This method is called from worker threads, so it must not modify engine's state
+     */
+    float evaluate(GP::Phenotype *pheno, IR::Node *text, bool run_time_optimize);
+
     /**
      * Sorts population based on phenotype's fitness.
      * Sort is descending from the best fitness to the worst.
@@ -0,0 +1,365 @@
+/**
+ * @file ebel_binary.cpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Precompiled binary ebel files
+ *
+ * Saving and loading of ebel programs in binary format (.ebelc),
+ * which can be loaded without any parsing.
+ */
+
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "ebel_binary.hpp"
+#include "ebe.hpp"
+#include "ir.hpp"
+#include "instruction.hpp"
+#include "symbol_table.hpp"
+#include "pragmas.hpp"
+#include "binary.hpp"
+#include "compiler.hpp"
+#include "logging.hpp"
+
+namespace {
+
+    /** Magic bytes at the start of every binary ebel file */
+    const char MAGIC[4] = {'E', 'B', 'L', 'C'};
+
+    /**
+     * Instruction names in order of their binary codes
+     * New instructions have to be added at the end (or BINARY_FORMAT_VERSION increased)
+     */
+    const char * const OPCODES[] = {
+        Inst::CALL::NAME,
+        Inst::CONCAT::NAME,
+        Inst::DEL::NAME,
+        Inst::LOOP::NAME,
+        Inst::NOP::NAME,
+        Inst::SWAP::NAME,
+        Inst::ADD::NAME,
+        Inst::DIV::NAME,
+        Inst::MOD::NAME,
+        Inst::MOVE::NAME,
+        Inst::MUL::NAME,
+        Inst::POW::NAME,
+        Inst::SUB::NAME
+    };
+    const size_t OPCODES_COUNT = sizeof(OPCODES) / sizeof(OPCODES[0]);
+
+    void corrupted() {
+        Error::error(Error::ErrorCode::SYNTACTIC, "Binary ebel file is corrupted");
+    }
+
+    void write_pass(IR::Pass *pass, Utils::BinaryWriter &out) {
+        out.write_u8(static_cast<uint8_t>(pass->get_type()));
+        if(pass->get_type() == IR::PassType::EXPRESSION_PASS) {
+            auto expr_pass = dynamic_cast<IR::PassExpression *>(pass);
+            out.write_u8(static_cast<uint8_t>(expr_pass->expr_type));
+            out.write_string(expr_pass->match);
+        }
+        if(pass->subpass_table == nullptr) {
+            out.write_u32(0);
+        }
+        else {
+            out.write_u32(static_cast<uint32_t>(pass->subpass_table->size()));
+            for(auto subpass: *pass->subpass_table) {
+                write_pass(subpass, out);
+            }
+        }
+        out.write_u32(static_cast<uint32_t>(pass->pipeline->size()));
+        for(auto inst: *pass->pipeline) {
+            // Names are compared by pointers, since get_name returns NAME of the class
+            size_t opcode = 0;
+            while(opcode < OPCODES_COUNT && OPCODES[opcode] != inst->get_name()) {
+                ++opcode;
+            }
+            if(opcode == OPCODES_COUNT) {
+                Error::error(Error::ErrorCode::INTERNAL, (std::string("Instruction ")+inst->get_name()
+                             +" cannot be saved into binary ebel").c_str());
+            }
+            out.write_u8(static_cast<uint8_t>(opcode));
+            inst->write_args(out);
+        }
+    }
+
+    /**
+     * Reads destination register of an instruction
+     * @param sym_table_size Symbol table size pragma (0 if not set, then the range is checked during interpretation)
+     */
+    int read_dst(Utils::BinaryReader &in, int sym_table_size) {
+        int dst = in.read_i32();
+        if(dst < 0 || (sym_table_size > 0 && dst >= sym_table_size)) {
+            corrupted();
+        }
+        return dst;
+    }
+
+    /**
+     * Reads source register of an instruction (negative for a constant argument)
+     * @param sym_table_size Symbol table size pragma (0 if not set, then the range is checked during interpretation)
+     */
+    int read_src(Utils::BinaryReader &in, int sym_table_size) {
+        int src = in.read_i32();
+        if(sym_table_size > 0 && src >= sym_table_size) {
+            corrupted();
+        }
+        return src;
+    }
+
+    Vars::Variable *read_variable(Utils::BinaryReader &in) {
+        switch(in.read_u8()) {
+        case IR::Type::NUMBER:
+            return new Vars::NumberVar(in.read_i32());
+        case IR::Type::FLOAT:
+            return new Vars::FloatVar(in.read_float());
+        case IR::Type::TEXT:
+            return new Vars::TextVar(in.read_string());
+        default:
+            corrupted();
+        }
+        return nullptr;
+    }
+
+    /**
+     * Reads arithmetic instruction arguments (as written by ArithmeticInstruction::write_args)
+     * @tparam T Instruction class
+     */
+    template<class T>
+    Inst::Instruction *read_arithmetic(Utils::BinaryReader &in, int sym_table_size) {
+        int dst = read_dst(in, sym_table_size);
+        int isrc1 = read_src(in, sym_table_size);
+        int isrc2 = read_src(in, sym_table_size);
+        Vars::Variable *src1 = isrc1 < 0 ? read_variable(in) : nullptr;
+        Vars::Variable *src2 = isrc2 < 0 ? read_variable(in) : nullptr;
+        return new T(dst, isrc1, isrc2, src1, src2);
+    }
+
+    Inst::Instruction *read_instruction(Utils::BinaryReader &in, size_t subpasses, int sym_table_size) {
+        uint8_t opcode = in.read_u8();
+        if(opcode >= OPCODES_COUNT) {
+            corrupted();
+        }
+        const char *name = OPCODES[opcode];
+        if(name == Inst::CALL::NAME) {
+            size_t index = in.read_u32();
+            if(index >= subpasses) {
+                corrupted();
+            }
+            return new Inst::CALL(index);
+        }
+        if(name == Inst::CONCAT::NAME) {
+            return new Inst::CONCAT(in.read_i32());
+        }
+        if(name == Inst::DEL::NAME) {
+            return new Inst::DEL();
+        }
+        if(name == Inst::LOOP::NAME) {
+            return new Inst::LOOP();
+        }
+        if(name == Inst::NOP::NAME) {
+            return new Inst::NOP();
+        }
+        if(name == Inst::SWAP::NAME) {
+            return new Inst::SWAP(in.read_i32());
+        }
+        if(name == Inst::MOVE::NAME) {
+            int dst = read_dst(in, sym_table_size);
+            int isrc1 = read_src(in, sym_table_size);
+            Vars::Variable *src1 = isrc1 < 0 ? read_variable(in) : nullptr;
+            return new Inst::MOVE(dst, isrc1, src1);
+        }
+        if(name == Inst::ADD::NAME) {
+            return read_arithmetic<Inst::ADD>(in, sym_table_size);
+        }
+        if(name == Inst::DIV::NAME) {
+            return read_arithmetic<Inst::DIV>(in, sym_table_size);
+        }
+        if(name == Inst::MOD::NAME) {
+            return read_arithmetic<Inst::MOD>(in, sym_table_size);
+        }
+        if(name == Inst::MUL::NAME) {
+            return read_arithmetic<Inst::MUL>(in, sym_table_size);
+        }
+        if(name == Inst::POW::NAME) {
+            return read_arithmetic<Inst::POW>(in, sym_table_size);
+        }
+        return read_arithmetic<Inst::SUB>(in, sym_table_size);
+    }
+
+    /**
+     * Checks that instructions can be interpreted by the pass (as the ebel parser does)
+     * Expression passes contain only expression instructions and other passes none of them.
+     * CALL can be only in words pass, it has to call an expression subpass and be followed
+     * by its return instruction (SWAP, DEL or NOP).
+     */
+    void check_pipeline(IR::Pass *pass) {
+        auto &pipeline = *pass->pipeline;
+        bool expr_pass = pass->get_type() == IR::PassType::EXPRESSION_PASS;
+        for(size_t i = 0; i < pipeline.size(); ++i) {
+            auto inst = pipeline[i];
+            if((dynamic_cast<Inst::ExprInstruction *>(inst) != nullptr) != expr_pass) {
+                corrupted();
+            }
+            if(inst->get_name() != Inst::CALL::NAME) {
+                continue;
+            }
+            if(pass->get_type() != IR::PassType::WORDS_PASS || i+1 >= pipeline.size()) {
+                corrupted();
+            }
+            auto ret = pipeline[i+1]->get_name();
+            if(ret != Inst::SWAP::NAME && ret != Inst::DEL::NAME && ret != Inst::NOP::NAME) {
+                corrupted();
+            }
+            auto index = dynamic_cast<Inst::CALL *>(inst)->get_arg1();
+            if(dynamic_cast<IR::PassExpression *>((*pass->subpass_table)[index]) == nullptr) {
+                corrupted();
+            }
+        }
+    }
+
+    /**
+     * Reads pass with its subpasses
+     * @param nested True for subpasses, which have to be expression passes (and only they can be)
+     */
+    IR::Pass *read_pass(Utils::BinaryReader &in, int sym_table_size, bool nested) {
+        IR::Pass *pass = nullptr;
+        switch(in.read_u8()) {
+        case IR::PassType::EXPRESSION_PASS: {
+            uint8_t expr_type = in.read_u8();
+            if(expr_type > IR::Type::DERIVED) {
+                corrupted();
+            }
+            pass = new IR::PassExpression(static_cast<IR::Type>(expr_type), in.read_string());
+        }
+        break;
+        case IR::PassType::WORDS_PASS:
+            pass = new IR::PassWords();
+        break;
+        case IR::PassType::LINES_PASS:
+            pass = new IR::PassLines();
+        break;
+        case IR::PassType::DOCUMENTS_PASS:
+            pass = new IR::PassDocuments();
+        break;
+        default:
+            corrupted();
+        }
+        if(nested != (pass->get_type() == IR::PassType::EXPRESSION_PASS)) {
+            corrupted();
+        }
+        uint32_t subpasses = in.read_u32();
+        if(subpasses > 0) {
+            // Only words passes have (expression) subpasses
+            if(pass->get_type() != IR::PassType::WORDS_PASS) {
+                corrupted();
+            }
+            pass->subpass_table = new std::vector<IR::Pass *>();
+            for(uint32_t i = 0; i < subpasses; ++i) {
+                pass->subpass_table->push_back(read_pass(in, sym_table_size, true));
+            }
+        }
+        uint32_t insts = in.read_u32();
+        for(uint32_t i = 0; i < insts; ++i) {
+            pass->push_back(read_instruction(in, subpasses, sym_table_size));
+        }
+        check_pipeline(pass);
+        return pass;
+    }
+}
+
+bool EbelFile::is_binary_name(const std::string &file_name) {
+    size_t ext_len = std::strlen(BINARY_EXTENSION);
+    return file_name.size() >= ext_len && file_name.compare(file_name.size() - ext_len, ext_len, BINARY_EXTENSION) == 0;
+}
+
+void EbelFile::save_binary(IR::EbelNode *ebel, std::ostream &out) {
+    Utils::BinaryWriter writer;
+    for(auto c: MAGIC) {
+        writer.write_u8(static_cast<uint8_t>(c));
+    }
+    writer.write_u32(BINARY_FORMAT_VERSION);
+    writer.write_u32(EBE_VERSION_MAJOR);
+    writer.write_u32(EBE_VERSION_MINOR);
+    writer.write_u32(EBE_VERSION_PATCH);
+    writer.write_i32(ebel->pragmas->get_sym_table_size());
+    writer.write_u32(static_cast<uint32_t>(ebel->nodes->size()));
+    for(auto pass: *ebel->nodes) {
+        write_pass(pass, writer);
+    }
+    auto &data = writer.get_data();
+    out.write(data.data(), data.size());
+}
+
+IR::EbelNode *EbelFile::load_binary(const char *file_name) {
+    int fd = open(file_name, O_RDONLY);
+    if(fd < 0) {
+        return nullptr;
+    }
+    // Reads into buffer until it is full or the file ends
+    auto read_all = [fd](char *buffer, size_t size) {
+        size_t done = 0;
+        while(done < size) {
+            ssize_t rc = read(fd, buffer + done, size - done);
+            if(rc <= 0) {
+                break;
+            }
+            done += rc;
+        }
+        return done;
+    };
+    // Only the magic is read for text ebel, the rest is read only for binary one
+    struct stat file_stat;
+    char magic[sizeof(MAGIC)];
+    if(fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)
+       || read_all(magic, sizeof(MAGIC)) < sizeof(MAGIC) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    std::string data;
+    data.resize(file_stat.st_size > static_cast<off_t>(sizeof(MAGIC)) ? file_stat.st_size - sizeof(MAGIC) : 0);
+    data.resize(read_all(&data[0], data.size()));
+    close(fd);
+    LOGMAX("Loading binary ebel " << file_name);
+
+    Utils::BinaryReader in(data.data(), data.size());
+    uint32_t format = in.read_u32();
+    if(format != BINARY_FORMAT_VERSION) {
+        Error::error(Error::ErrorCode::VERSION, (std::string("Binary ebel format version ")+std::to_string(format)
+                     +" is not supported (supported version is "+std::to_string(BINARY_FORMAT_VERSION)
+                     +"), ebel has to be compiled again").c_str());
+    }
+    int major = in.read_u32();
+    int minor = in.read_u32();
+    int patch = in.read_u32();
+    if(!Pragma::Pragmas::is_version_fulfilled(major, minor, patch)) {
+        Error::error(Error::ErrorCode::VERSION,
+                     (
+                        std::string("Current Ebe version ")
+                        +std::to_string(EBE_VERSION_MAJOR)+"."
+                        +std::to_string(EBE_VERSION_MINOR)+"."
+                        +std::to_string(EBE_VERSION_PATCH)
+                        +std::string(" cannot load binary ebel saved by version ")
+                        +std::to_string(major)+"."+std::to_string(minor)+"."+std::to_string(patch)
+                     ).c_str());
+    }
+
+    auto ebel = new IR::EbelNode();
+    int sym_table_size = in.read_i32();
+    if(sym_table_size < 0) {
+        corrupted();
+    }
+    ebel->pragmas->set_sym_table_size(sym_table_size);
+    uint32_t passes = in.read_u32();
+    for(uint32_t i = 0; i < passes; ++i) {
+        ebel->push_back(read_pass(in, sym_table_size, false));
+    }
+    if(!in.at_end()) {
+        corrupted();
+    }
+    return ebel;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file ebel_binary.hpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Precompiled binary ebel files
+ *
+ * Saving and loading of ebel programs in binary format (.ebelc),
+ * which can be loaded without any parsing.
+ */
+
+#ifndef _EBEL_BINARY_HPP_
+#define _EBEL_BINARY_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "ir.hpp"
+
+namespace EbelFile {
+
+    /**
+     * Binary ebel format version
+     * Has to be increased with every change of the format, files with
+     * other format version are refused
+     */
+    const uint32_t BINARY_FORMAT_VERSION = 1;
+
+    /** File extension for which is ebel saved in binary format */
+    const char * const BINARY_EXTENSION = ".ebelc";
+
+    /**
+     * @param file_name File name
+     * @return True if ebel should be saved into the file in binary format (based on its extension)
+     */
+    bool is_binary_name(const std::string &file_name);
+
+    /**
+     * Saves ebel program in binary format
+     * Format starts with a header holding magic bytes, format version and Ebe version,
+     * which is required to load the file (checked as the requires pragma).
+     * Header is followed by pragmas and passes with their subpasses and instructions.
+     * @param ebel Program to save
+     * @param out Output stream (opened in binary mode)
+     */
+    void save_binary(IR::EbelNode *ebel, std::ostream &out);
+
+    /**
+     * Loads ebel program saved in binary format
+     * File is read by a single read and no parsing is needed
+     * @param file_name Path to the file
+     * @return Loaded program or nullptr if the file is not a binary ebel file
+     *         (or cannot be read, the error is then reported by text ebel loading)
+     */
+    IR::EbelNode *load_binary(const char *file_name);
+
+}
+
+#endif//_EBEL_BINARY_HPP_
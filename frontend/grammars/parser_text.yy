@@ -118,16 +118,16 @@ sentence  : word
           ;
 
 /* Word can be of many types */
-word      : TEXT         { scanner->add_text($1);      }
-          | MINUS NUMBER { scanner->add_number($1+$2); }
-          | NUMBER       { scanner->add_number($1);    }
-          | MINUS FLOAT  { scanner->add_float($1+$2);  }
-          | FLOAT        { scanner->add_float($1);     }
-          | DELIMITER    { scanner->add_delimiter($1); }
-          | SYMBOL       { scanner->add_symbol($1);    }
-          | NEWLINE      { scanner->add_newline();     }
-          | operator     { scanner->add_symbol($1);    }
-          | QUOTE        { scanner->add_symbol("\"");  }
+word      : TEXT         { scanner->add_text(std::move($1));      }
+          | MINUS NUMBER { scanner->add_number($1+$2);            }
+          | NUMBER       { scanner->add_number(std::move($1));    }
+          | MINUS FLOAT  { scanner->add_float($1+$2);             }
+          | FLOAT        { scanner->add_float(std::move($1));     }
+          | DELIMITER    { scanner->add_delimiter(std::move($1)); }
+          | SYMBOL       { scanner->add_symbol(std::move($1));    }
+          | NEWLINE      { scanner->add_newline();                }
+          | operator     { scanner->add_symbol(std::move($1));    }
+          | QUOTE        { scanner->add_symbol("\"");             }
           | FALSE_EXPR_BEGIN { scanner->add_symbol("{"); scanner->add_symbol("!"); }
           | FALSE_EXPR_END   { scanner->add_symbol("!"); scanner->add_symbol("}"); }
           | EXPR_BEGIN QUOTE string_v QUOTE EXPR_END {auto e = Expression(Node(Type::TEXT, $3), std::vector<Expression>{});
@@ -859,61 +859,61 @@ namespace  TextFile  {
             {
   case 6: // word: TEXT
 #line 121 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_text(yystack_[0].value.as < std::string > ());      }
+                         { scanner->add_text(std::move(yystack_[0].value.as < std::string > ()));      }
 #line 864 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 7: // word: "-" NUMBER
 #line 122 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_number(yystack_[1].value.as < std::string > ()+yystack_[0].value.as < std::string > ()); }
+                         { scanner->add_number(yystack_[1].value.as < std::string > ()+yystack_[0].value.as < std::string > ());            }
 #line 870 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 8: // word: NUMBER
 #line 123 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_number(yystack_[0].value.as < std::string > ());    }
+                         { scanner->add_number(std::move(yystack_[0].value.as < std::string > ()));    }
 #line 876 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 9: // word: "-" FLOAT
 #line 124 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_float(yystack_[1].value.as < std::string > ()+yystack_[0].value.as < std::string > ());  }
+                         { scanner->add_float(yystack_[1].value.as < std::string > ()+yystack_[0].value.as < std::string > ());             }
 #line 882 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 10: // word: FLOAT
 #line 125 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_float(yystack_[0].value.as < std::string > ());     }
+                         { scanner->add_float(std::move(yystack_[0].value.as < std::string > ()));     }
 #line 888 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 11: // word: DELIMITER
 #line 126 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_delimiter(yystack_[0].value.as < std::string > ()); }
+                         { scanner->add_delimiter(std::move(yystack_[0].value.as < std::string > ())); }
 #line 894 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 12: // word: SYMBOL
 #line 127 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_symbol(yystack_[0].value.as < std::string > ());    }
+                         { scanner->add_symbol(std::move(yystack_[0].value.as < std::string > ()));    }
 #line 900 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 13: // word: NEWLINE
 #line 128 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_newline();     }
+                         { scanner->add_newline();                }
 #line 906 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 14: // word: operator
 #line 129 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_symbol(yystack_[0].value.as < std::string > ());    }
+                         { scanner->add_symbol(std::move(yystack_[0].value.as < std::string > ()));    }
 #line 912 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
   case 15: // word: "\""
 #line 130 "/home/marek/Desktop/Skola/dp/ebe/frontend/grammars/parser_text.yy"
-                         { scanner->add_symbol("\"");  }
+                         { scanner->add_symbol("\"");             }
 #line 918 "/home/marek/Desktop/Skola/dp/ebe/frontend/parser_text.cpp"
     break;
 
@@ -144,21 +144,7 @@ void Pragmas::parse(std::string value) {
                          "Incorrect version number in requires pragma",
                          &e);
         }
-        bool version_ok = true;
-        if(major > EBE_VERSION_MAJOR) {
-            version_ok = false;
-        }
-        else if(major == EBE_VERSION_MAJOR) {
-            if(minor > EBE_VERSION_MINOR) {
-                version_ok = false;
-            }
-            else if(minor == EBE_VERSION_MINOR) {
-                if(patch > EBE_VERSION_PATCH) {
-                    version_ok = false;
-                }
-            }
-        }
-        if(!version_ok) {
+        if(!is_version_fulfilled(major, minor, patch)) {
             Error::error(Error::ErrorCode::VERSION, 
                          (
                             std::string("Current Ebe version ")
@@ -176,8 +162,19 @@ void Pragmas::parse(std::string value) {
     }
 }
 
+bool Pragmas::is_version_fulfilled(int major, int minor, int patch) {
+    if(major != EBE_VERSION_MAJOR) {
+        return major < EBE_VERSION_MAJOR;
+    }
+    if(minor != EBE_VERSION_MINOR) {
+        return minor < EBE_VERSION_MINOR;
+    }
+    return patch <= EBE_VERSION_PATCH;
+}
+
 void Pragmas::apply() {
-    if(this->sym_table_size > 0) {
+    // Option is written only when it changes, so that parallel interpreters only read it
+    if(this->sym_table_size > 0 && Args::arg_opts.sym_table_size != this->sym_table_size) {
         Args::arg_opts.sym_table_size = this->sym_table_size;
         LOG1("Applied pragma: sym_table_size = " << this->sym_table_size);
     }
@@ -50,6 +50,24 @@ public:
      * @brief Applies parsed pragmas
      */
     void apply();
+
+    /** @return Symbol table size pragma value (0 if not set) */
+    int get_sym_table_size() const { return sym_table_size; }
+
+    /**
+     * @brief Sets symbol table size pragma (used when loading binary ebel)
+     * @param size Symbol table size (0 if not set)
+     */
+    void set_sym_table_size(int size) { sym_table_size = size; }
+
+    /**
+     * @brief Checks if current Ebe version is at least the required one
+     * @param major Required major version
+     * @param minor Required minor version
+     * @param patch Required patch
+     * @return True if current version fulfills the required one
+     */
+    static bool is_version_fulfilled(int major, int minor, int patch);
 };
 }
 
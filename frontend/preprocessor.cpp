@@ -16,6 +16,7 @@
 #include <vector>
 #include "preprocessor.hpp"
 #include "compiler.hpp"
+#include "utils.hpp"
 
 #include <iostream>
 
@@ -25,6 +26,11 @@ Preprocessor::Preprocessor() : Compiler("Preprocessor") {
 
 std::istream *Preprocessor::process(const char *file_name){
     if(file_name){
+        // Regular files are mapped into memory, the rest (pipes, devices) is read through file stream
+        auto mapped = Utils::MappedFileStream::open(file_name);
+        if(mapped) {
+            return mapped;
+        }
         auto f = new std::ifstream(file_name);
         if(f->fail()){
             error(Error::ErrorCode::FILE_ACCESS, file_name, -1, -1, "Could not open file");
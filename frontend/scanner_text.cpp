@@ -12,8 +12,13 @@
 
 #include <istream>
 #include <sstream>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <unistd.h>
 #include "scanner_text.hpp"
 #include "parser_text.hpp"
+#include "tokenizer_text.hpp"
 #include "scanner.hpp"
 #include "ir.hpp"
 #include "expression.hpp"
@@ -21,18 +26,28 @@
 #include "arg_parser.hpp"
 #include "symbol_table.hpp"
 #include "instruction.hpp"
+#include "workers.hpp"
+#include "utils.hpp"
 
 #include <iostream>
 
 using namespace TextFile;
 
-ScannerText::ScannerText() : Scanner("Text scanner"), yyFlexLexer() {
+ScannerText::ScannerText() : Scanner("Text scanner"), yyFlexLexer(), line_handler{nullptr}, interactive{false}, use_tokenizer{true} {
     
 }
 
+int ScannerText::LexerInput(char *buf, int max_size) {
+    if(this->interactive) {
+        return yyFlexLexer::LexerInput(buf, max_size);
+    }
+    return static_cast<int>(yyin.rdbuf()->sgetn(buf, max_size));
+}
+
 IR::Node *ScannerText::process(std::istream *text, const char *file_name) {
     // Set lexer to new stream
     this->switch_streams(text);
+    this->interactive = text == &std::cin && isatty(STDIN_FILENO);
     this->current_file_name = file_name;
     loc = new TextFile::ParserText::location_type();
     this->expr_type = IR::Type::DERIVED;
@@ -42,17 +57,22 @@ IR::Node *ScannerText::process(std::istream *text, const char *file_name) {
     this->current_parse = new IR::Node();
     this->current_line = nullptr;
 
-    auto parser = new TextFile::ParserText(this);
-
-    if(parser->parse() != 0){
-        this->error(Error::ErrorCode::SYNTACTIC, file_name, 0, 0, 
-                    (std::string("Parsing failed for file ")+std::string(file_name)).c_str());
+    TextFile::ParserText *parser = nullptr;
+    if(this->use_tokenizer && !Args::arg_opts.expr && !this->interactive) {
+        this->tokenize(text);
+    }
+    else {
+        parser = new TextFile::ParserText(this);
+        if(parser->parse() != 0){
+            this->error(Error::ErrorCode::SYNTACTIC, file_name, 0, 0, 
+                        (std::string("Parsing failed for file ")+std::string(file_name)).c_str());
+        }
     }
 
     if(this->current_line != nullptr) {
         // To avoid pushing empty line created automatically lines are created by new words
         // thus current_line might be nullptr if it wasn't created
-        this->current_parse->push_back(this->current_line);
+        this->push_line();
     }
 
     // Set private variables to nullptr to make sure nothing else touches them
@@ -64,6 +84,114 @@ IR::Node *ScannerText::process(std::istream *text, const char *file_name) {
     return parsed;
 }
 
+void ScannerText::process(std::istream *text, const char *file_name, const TLineHandler &handler) {
+    this->line_handler = &handler;
+    // Returned node is empty since all lines were passed to the handler
+    delete this->process(text, file_name);
+    this->line_handler = nullptr;
+}
+
+IR::Node *ScannerText::process(std::istream *text, const char *file_name, WorkerPool &workers) {
+    bool interactive_in = text == &std::cin && isatty(STDIN_FILENO);
+    if(workers.size() < 2 || !this->use_tokenizer || Args::arg_opts.expr || interactive_in) {
+        return this->process(text, file_name);
+    }
+    // Whole text is read, since the whole IR is created anyway.
+    // Mapped files are tokenized in place, other streams (pipes, stdin) are copied into memory.
+    std::string copy;
+    std::string_view data;
+    if(auto mapped = dynamic_cast<Utils::MappedFileStream *>(text)) {
+        data = mapped->take();
+    }
+    else {
+        const size_t BLOCK_SIZE = 1024*1024;
+        size_t read;
+        do {
+            size_t used = copy.size();
+            copy.resize(used + BLOCK_SIZE);
+            read = static_cast<size_t>(text->rdbuf()->sgetn(&copy[used], BLOCK_SIZE));
+            copy.resize(used + read);
+        } while(read > 0);
+        data = copy;
+    }
+
+    // More chunks than workers balance different line lengths, but chunks should not be too small
+    const size_t MIN_CHUNK_SIZE = 256*1024;
+    size_t chunks = std::max<size_t>(1, std::min(workers.size() * 4, data.size() / MIN_CHUNK_SIZE));
+    const char *end = data.data() + data.size();
+    std::vector<const char *> bounds{data.data()};
+    for(size_t i = 1; i < chunks; ++i) {
+        const char *split = std::max<const char *>(data.data() + i * (data.size() / chunks), bounds.back());
+        auto nl = static_cast<const char *>(std::memchr(split, '\n', end - split));
+        bounds.push_back(nl == nullptr ? end : nl + 1);
+    }
+    bounds.push_back(end);
+
+    std::vector<IR::Node *> parts(chunks);
+    workers.run(chunks, [&](size_t, size_t i) {
+        parts[i] = new IR::Node();
+        TokenizerText::tokenize_lines(bounds[i], bounds[i+1], *parts[i]);
+    });
+
+    auto parsed = new IR::Node();
+    for(auto part: parts) {
+        // The first of the longest lines is kept (as in IR::Node::push_back)
+        if(part->longest_line != nullptr && 
+           (parsed->longest_line == nullptr || part->longest_line->size() > parsed->longest_line->size())) {
+            parsed->longest_line = part->longest_line;
+        }
+        parsed->nodes->splice(parsed->nodes->end(), *part->nodes);
+        delete part;
+    }
+    return parsed;
+}
+
+void ScannerText::tokenize(std::istream *text) {
+    // Text is read in blocks and only whole lines are tokenized, the rest is
+    // moved to the start of the buffer, words never span over new lines
+    const size_t BLOCK_SIZE = 256*1024;
+    std::string buffer;
+    size_t used = 0;
+    while(true) {
+        if(buffer.size() < used + BLOCK_SIZE) {
+            buffer.resize(used + BLOCK_SIZE);
+        }
+        size_t read = static_cast<size_t>(text->rdbuf()->sgetn(&buffer[used], BLOCK_SIZE));
+        used += read;
+        const char *data = buffer.data();
+        const char *end = data + used;
+        const char *line = data;
+        const char *nl;
+        while((nl = static_cast<const char *>(std::memchr(line, '\n', end - line))) != nullptr) {
+            if(line != nl) {
+                this->touch_line();
+                TokenizerText::tokenize(line, nl, *this->current_line);
+            }
+            this->add_newline();
+            line = nl + 1;
+        }
+        if(read == 0) {
+            if(line != end) {
+                // Last line without new line is pushed by process
+                this->touch_line();
+                TokenizerText::tokenize(line, end, *this->current_line);
+            }
+            break;
+        }
+        used = end - line;
+        std::memmove(&buffer[0], line, used);
+    }
+}
+
+void ScannerText::push_line() {
+    if(this->line_handler) {
+        (*this->line_handler)(this->current_line);
+    }
+    else {
+        this->current_parse->push_back(this->current_line);
+    }
+}
+
 void ScannerText::deducted_expr_type(IR::Type type) {
     if(multiple_expr_types) {
         return;
@@ -112,29 +240,29 @@ bool ScannerText::is_in_str() {
     return this->inside_string;
 }
 
-void ScannerText::add_text(const std::string &v) {
+void ScannerText::add_text(std::string v) {
     this->touch_line();
-    current_line->push_back(new IR::Word(v, IR::Type::TEXT));
+    current_line->push_back(new IR::Word(std::move(v), IR::Type::TEXT));
 }
 
-void ScannerText::add_number(const std::string &v) {
+void ScannerText::add_number(std::string v) {
     this->touch_line();
-    current_line->push_back(new IR::Word(v, IR::Type::NUMBER));
+    current_line->push_back(new IR::Word(std::move(v), IR::Type::NUMBER));
 }
 
-void ScannerText::add_delimiter(const std::string &v) {
+void ScannerText::add_delimiter(std::string v) {
     this->touch_line();
-    current_line->push_back(new IR::Word(v, IR::Type::DELIMITER));
+    current_line->push_back(new IR::Word(std::move(v), IR::Type::DELIMITER));
 }
 
-void ScannerText::add_symbol(const std::string &v) {
+void ScannerText::add_symbol(std::string v) {
     this->touch_line();
-    current_line->push_back(new IR::Word(v, IR::Type::SYMBOL));
+    current_line->push_back(new IR::Word(std::move(v), IR::Type::SYMBOL));
 }
 
-void ScannerText::add_float(const std::string &v) {
+void ScannerText::add_float(std::string v) {
     this->touch_line();
-    current_line->push_back(new IR::Word(v, IR::Type::FLOAT));
+    current_line->push_back(new IR::Word(std::move(v), IR::Type::FLOAT));
 }
 
 void ScannerText::add_newline() {
@@ -143,7 +271,7 @@ void ScannerText::add_newline() {
         this->current_line = new std::list<IR::Word *>{new IR::Word("", IR::Type::EMPTY)};
     }
     // Push current line
-    this->current_parse->push_back(this->current_line);
+    this->push_line();
     // Reset current line to force creating new one on input
     this->current_line = nullptr;
 }
@@ -19,16 +19,25 @@
 #endif
 #include <istream>
 #include <list>
+#include <functional>
 #include "ir.hpp"
 #include "scanner.hpp"
 #include "parser_text.hpp"
 #include "expression.hpp"
 
+class WorkerPool;
+
 /**
  * Namespace for lexers and parsers used by flex and bison/yacc.
  */ 
 namespace TextFile {
 
+/**
+ * Function receiving parsed lines
+ * Receiver takes ownership of the line and its words
+ */
+using TLineHandler = std::function<void(std::list<IR::Word *> *)>;
+
 /**
  * Scanner for text files 
  */ 
@@ -42,10 +51,33 @@ private:
 
     IR::Node *current_parse;              ///< Holds node that is currently being parsed during process method
     std::list<IR::Word *> *current_line;  ///< Holds line currently being parsed during process method
+    const TLineHandler *line_handler;     ///< When set, parsed lines are passed to it instead of current_parse
+    bool interactive;                     ///< Input is read character by character (terminal input)
+    bool use_tokenizer;                   ///< If hand-written tokenizer can be used instead of flex lexer
+
+    /**
+     * Reads input for the lexer
+     * Input is read in blocks rather than by single characters (which flex does by default),
+     * unless it is an interactive terminal input
+     * @param buf Buffer to read into
+     * @param max_size Maximum number of characters to read
+     * @return Number of characters read, 0 at the end of input
+     */
+    int LexerInput(char *buf, int max_size) override;
+
+    /**
+     * Parses text using hand-written tokenizer
+     * Can be used only when expressions are not parsed
+     * @param text Input text stream
+     */
+    void tokenize(std::istream *text);
 
     /** If current line is nullptr allocates a new one */
     void touch_line();
 
+    /** Passes parsed current_line into current_parse or line_handler */
+    void push_line();
+
     /** 
      * Used by the lexer to denot that expression might start now
      */ 
@@ -90,14 +122,14 @@ public:
     /**
      * @defgroup wordparse Word parsers
      * Receive Word of certain type and add it to the current_parse.
-     * @param v Text of the word
+     * @param v Text of the word, it is moved into the word
      * @{
      */  
-    void add_text(const std::string &v);
-    void add_number(const std::string &v);
-    void add_delimiter(const std::string &v);
-    void add_symbol(const std::string &v);
-    void add_float(const std::string &v);
+    void add_text(std::string v);
+    void add_number(std::string v);
+    void add_delimiter(std::string v);
+    void add_symbol(std::string v);
+    void add_float(std::string v);
     void add_newline();
     void add_expr(Expr::Expression *e, IR::Type type);
     /** @} */
@@ -127,7 +159,36 @@ public:
      */ 
     bool is_in_str();
 
+    /**
+     * Sets if hand-written tokenizer (TextFile::TokenizerText) is used for texts without expressions
+     * Tokenizer produces the same words as flex lexer and is enabled by default
+     * @param enable If tokenizer should be used
+     */
+    void set_tokenizer(bool enable) { this->use_tokenizer = enable; }
+
     IR::Node *process(std::istream *text, const char *file_name) override;
+
+    /**
+     * Parses text and passes every line to handler as soon as it is parsed
+     * No IR of the whole text is created, so memory does not depend on the text size
+     * @param text Input text stream
+     * @param file_name Name of the parsed file
+     * @param handler Function receiving parsed lines (in order)
+     */
+    void process(std::istream *text, const char *file_name, const TLineHandler &handler);
+
+    /**
+     * Parses text using multiple threads
+     * Text is split into chunks on line ends and every chunk is tokenized by one worker,
+     * the lines are then joined in order. Texts which cannot be tokenized (with expressions
+     * or interactive input) are parsed by the flex lexer in the calling thread.
+     * @param text Input text stream
+     * @param file_name Name of the parsed file
+     * @param workers Worker pool to use
+     * @return Parsed IR
+     * @note Cannot be called from a worker pool task
+     */
+    IR::Node *process(std::istream *text, const char *file_name, WorkerPool &workers);
 };
 
 }
@@ -0,0 +1,222 @@
+/**
+ * @file tokenizer_text.cpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Hand-written tokenizer for text files
+ *
+ * Fast alternative to the flex lexer and bison parser for texts without expressions.
+ */
+
+#include <array>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include "tokenizer_text.hpp"
+#include "ir.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace TextFile;
+
+namespace {
+
+    /** Character classes of the lexer, word characters have to be last */
+    enum CharClass : uint8_t {
+        SYMBOL,     ///< Any other character
+        DELIMITER,  ///< [ \f\r\t\v,.:;]
+        MINUS,      ///< Can be a sign of a number
+        DIGIT,      ///< [0-9]
+        LETTER      ///< [a-zA-Z\_\x80-\xf3]
+    };
+
+    /** @return Class of every character as in lexer_text.ll */
+    constexpr std::array<uint8_t, 256> make_classes() {
+        std::array<uint8_t, 256> classes{};
+        for(int c = 0; c < 256; ++c) {
+            if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || (c >= 0x80 && c <= 0xf3)) {
+                classes[c] = LETTER;
+            }
+            else if(c >= '0' && c <= '9') {
+                classes[c] = DIGIT;
+            }
+            else if(c == ' ' || c == '\f' || c == '\r' || c == '\t' || c == '\v' ||
+                    c == ',' || c == '.' || c == ':' || c == ';') {
+                classes[c] = DELIMITER;
+            }
+            else if(c == '-') {
+                classes[c] = MINUS;
+            }
+            else {
+                classes[c] = SYMBOL;
+            }
+        }
+        return classes;
+    }
+
+    constexpr std::array<uint8_t, 256> CLASSES = make_classes();
+
+    inline uint8_t char_class(char c) {
+        return CLASSES[static_cast<unsigned char>(c)];
+    }
+
+    inline bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+#ifdef __SSE2__
+    /**
+     * @param p Start of 16 characters
+     * @return Bit mask of characters which are letters or digits
+     */
+    inline unsigned word_mask(const char *p) {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        // Upper case letters are turned into lower case ones, nothing else gets into [a-z]
+        const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+        const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a'-1)),
+                                             _mm_cmplt_epi8(lower, _mm_set1_epi8('z'+1)));
+        const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0'-1)),
+                                            _mm_cmplt_epi8(c, _mm_set1_epi8('9'+1)));
+        const __m128i underscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+        // Characters 0x80-0xf3 are signed values smaller than 0xf4 (-12)
+        const __m128i utf = _mm_cmplt_epi8(c, _mm_set1_epi8(static_cast<char>(0xf4)));
+        const __m128i word = _mm_or_si128(_mm_or_si128(letter, digit), _mm_or_si128(underscore, utf));
+        return static_cast<unsigned>(_mm_movemask_epi8(word));
+    }
+#endif
+
+    /**
+     * @param p Start of a word ([a-zA-Z0-9\_\x80-\xf3]+)
+     * @param end End of the line
+     * @return End of the word
+     */
+    const char *word_end(const char *p, const char *end) {
+#ifdef __SSE2__
+        while(end - p >= 16) {
+            unsigned others = ~word_mask(p) & 0xffff;
+            if(others != 0) {
+                return p + __builtin_ctz(others);
+            }
+            p += 16;
+        }
+#endif
+        while(p < end && char_class(*p) >= DIGIT) {
+            ++p;
+        }
+        return p;
+    }
+
+    /**
+     * @param p Start of digits
+     * @param end End of the line
+     * @return End of the digits
+     */
+    const char *digits_end(const char *p, const char *end) {
+        while(p < end && is_digit(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    /**
+     * Finds the longest match of number, float and text rules starting with a digit
+     * @param p Start of the word (a digit)
+     * @param end End of the line
+     * @param type Type of the word found
+     * @return End of the word
+     */
+    const char *scan_number(const char *p, const char *end, IR::Type &type) {
+        const char *word = word_end(p, end);
+        if(digits_end(p, word) != word) {
+            // Text is longer than any number
+            type = IR::Type::TEXT;
+            return word;
+        }
+        type = IR::Type::NUMBER;
+        if(end - word < 2 || *word != '.' || !is_digit(word[1])) {
+            return word;
+        }
+        // Float, possibly with an exponent
+        type = IR::Type::FLOAT;
+        const char *fraction = digits_end(word+1, end);
+        if(fraction < end && (*fraction == 'e' || *fraction == 'E')) {
+            const char *exponent = fraction + 1;
+            if(exponent < end && (*exponent == '+' || *exponent == '-')) {
+                ++exponent;
+            }
+            if(exponent < end && is_digit(*exponent)) {
+                return digits_end(exponent, end);
+            }
+        }
+        return fraction;
+    }
+
+    inline void add_word(std::list<IR::Word *> &line, const char *begin, const char *end, IR::Type type) {
+        line.push_back(new IR::Word(std::string(begin, end), type));
+    }
+}
+
+void TokenizerText::tokenize(const char *begin, const char *end, std::list<IR::Word *> &line) {
+    const char *p = begin;
+    while(p < end) {
+        const char *next;
+        IR::Type type;
+        switch(char_class(*p)) {
+        case DELIMITER:
+            add_word(line, p, p+1, IR::Type::DELIMITER);
+            ++p;
+            break;
+        case DIGIT:
+            next = scan_number(p, end, type);
+            add_word(line, p, next, type);
+            p = next;
+            break;
+        case LETTER:
+            next = word_end(p+1, end);
+            add_word(line, p, next, IR::Type::TEXT);
+            p = next;
+            break;
+        case MINUS:
+            // Minus directly followed by a number or float is a part of it (parser rules)
+            if(p+1 < end && is_digit(p[1])) {
+                next = scan_number(p+1, end, type);
+                if(type != IR::Type::TEXT) {
+                    add_word(line, p, next, type);
+                    p = next;
+                    break;
+                }
+            }
+            add_word(line, p, p+1, IR::Type::SYMBOL);
+            ++p;
+            break;
+        default:
+            // Lexer passes symbols as C strings, so null character is an empty symbol
+            add_word(line, p, *p == '\0' ? p : p+1, IR::Type::SYMBOL);
+            ++p;
+            break;
+        }
+    }
+}
+
+void TokenizerText::tokenize_lines(const char *begin, const char *end, IR::Node &node) {
+    const char *line = begin;
+    while(line < end) {
+        auto nl = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        if(nl == nullptr) {
+            nl = end;
+        }
+        auto words = new std::list<IR::Word *>();
+        if(line == nl) {
+            // Empty line is represented with EMPTY word (as in ScannerText::add_newline)
+            words->push_back(new IR::Word("", IR::Type::EMPTY));
+        }
+        else {
+            tokenize(line, nl, *words);
+        }
+        node.push_back(words);
+        line = nl + 1;
+    }
+}
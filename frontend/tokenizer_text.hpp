@@ -0,0 +1,48 @@
+/**
+ * @file tokenizer_text.hpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Hand-written tokenizer for text files
+ *
+ * Fast alternative to the flex lexer and bison parser for texts without expressions.
+ */
+
+#ifndef _TOKENIZER_TEXT_HPP_
+#define _TOKENIZER_TEXT_HPP_
+
+#include <list>
+#include "ir.hpp"
+
+namespace TextFile {
+
+    /**
+     * Tokenizer splitting text lines into words
+     * Produces the same words as the flex lexer (lexer_text.ll) together with the
+     * bison parser (parser_text.yy) do when expressions are not parsed, but token
+     * boundaries are searched for many characters at once (using SSE2 when available).
+     */
+    class TokenizerText {
+    public:
+        /**
+         * Splits one line into words
+         * @param begin Start of the line
+         * @param end End of the line (the new line character is not part of it)
+         * @param line Line into which are the words appended
+         */
+        static void tokenize(const char *begin, const char *end, std::list<IR::Word *> &line);
+
+        /**
+         * Splits text into lines of words and appends them into IR
+         * Last line does not have to end with a new line
+         * @param begin Start of the text (start of a line)
+         * @param end End of the text
+         * @param node IR into which are the lines appended
+         */
+        static void tokenize_lines(const char *begin, const char *end, IR::Node &node);
+    };
+
+}
+
+#endif//_TOKENIZER_TEXT_HPP_
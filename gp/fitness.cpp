@@ -12,6 +12,7 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include "fitness.hpp"
 #include "ir.hpp"
 
@@ -38,10 +39,10 @@ float Fitness::one2one(IR::Node *ir1, IR::Node *ir2) {
             const auto& ir2_word_end = (*ir2_line)->end();
             while(ir1_word != ir1_word_end && ir2_word != ir2_word_end){
                 // User defined expressions are always a match
-                if((*ir1_word)->type == IR::Type::EXPRESSION || (*ir2_word)->type == IR::Type::EXPRESSION){
+                if((*ir1_word)->get_type() == IR::Type::EXPRESSION || (*ir2_word)->get_type() == IR::Type::EXPRESSION){
                     ++matched;
                 }
-                else if(**ir1_word == **ir2_word){
+                else if((*ir1_word)->same_text(**ir2_word)){
                     ++matched;
                 }
                 ir1_word = std::next(ir1_word);
@@ -93,284 +94,314 @@ float Fitness::one2one(IR::Node *ir1, IR::Node *ir2) {
     return static_cast<float>(matched) / max_size;
 }
 
-float Fitness::levenshtein(IR::Node *ir1, IR::Node *ir2) {
-    // TODO: Move linearization into IR as a method
-    // Create new line word to connect IR in matrix
-    // TODO: Optimize by having the linearization a static arg in compilation
-    IR::Word nl(std::string("\n"), IR::Type::DELIMITER);
-
-    // Move IR into linear version
-    std::vector<IR::Word *> ir1_v;
-    auto ir1_line = ir1->nodes->begin();
-    const auto& ir1_end = ir1->nodes->end();
-    size_t ir1_size = 0;
-    while(ir1_line != ir1_end){
-        // Iterate words in lines
-        auto ir1_word = (*ir1_line)->begin();
-        const auto& ir1_word_end = (*ir1_line)->end();
-        while(ir1_word != ir1_word_end){
-            ir1_v.push_back(*ir1_word);
-            ir1_word = std::next(ir1_word);
-            ++ir1_size;
-        }
-        ir1_v.push_back(&nl);
-        ++ir1_size;
-        ir1_line = std::next(ir1_line);
+namespace {
+    /**
+     * Checks if 2 tokens match
+     * Expressions match anything and words not in target match nothing
+     */
+    inline bool match(uint32_t t1, uint32_t t2) {
+        return t1 == WILDCARD || t2 == WILDCARD || (t1 == t2 && t1 != UNKNOWN);
     }
 
-    std::vector<IR::Word *> ir2_v;
-    auto ir2_line = ir2->nodes->begin();
-    const auto& ir2_end = ir2->nodes->end();
-    size_t ir2_size = 0;
-    while(ir2_line != ir2_end){
-        // Iterate words in lines
-        auto ir2_word = (*ir2_line)->begin();
-        const auto& ir2_word_end = (*ir2_line)->end();
-        while(ir2_word != ir2_word_end){
-            ir2_v.push_back(*ir2_word);
-            ir2_word = std::next(ir2_word);
-            ++ir2_size;
+    /**
+     * Computes Levenshtein distance of 2 token sequences
+     * Uses Myers's bit-vector algorithm (in Hyyro's block form). Pattern is processed in 64 token
+     * blocks, each over the whole text, and the horizontal deltas of the block's last row are passed
+     * to the next block. This makes the memory linear in size of the text.
+     * @param pattern Pattern tokens (shorter sequence is faster as pattern)
+     * @param pattern_size Amount of pattern tokens to use
+     * @param text Text tokens
+     * @param text_size Amount of text tokens to use
+     * @param symbols Amount of interned token IDs, IDs above it (except for WILDCARD) match nothing
+     * @return Levenshtein distance
+     */
+    size_t edit_distance(const std::vector<uint32_t> &pattern, size_t pattern_size,
+                         const std::vector<uint32_t> &text, size_t text_size, size_t symbols) {
+        if(pattern_size == 0) {
+            return text_size;
+        }
+        if(text_size == 0) {
+            return pattern_size;
+        }
+        // Positions of each token in text (CSR)
+        std::vector<size_t> occ_start(symbols+1, 0);
+        for(size_t j = 0; j < text_size; ++j) {
+            if(text[j] < symbols) {
+                ++occ_start[text[j]+1];
+            }
+        }
+        for(size_t s = 0; s < symbols; ++s) {
+            occ_start[s+1] += occ_start[s];
+        }
+        std::vector<size_t> occ(occ_start[symbols]);
+        {
+            std::vector<size_t> cursor(occ_start.begin(), occ_start.end()-1);
+            for(size_t j = 0; j < text_size; ++j) {
+                if(text[j] < symbols) {
+                    occ[cursor[text[j]]++] = j;
+                }
+            }
         }
-        ir2_v.push_back(&nl);
-        ++ir2_size;
-        ir2_line = std::next(ir2_line);
-    }
-
-    if(ir1_size == 0 && ir2_size == 0) {
-        return 1.0f;
-    }
-    if(ir1_size == 0 || ir2_size == 0) {
-        return 0.0f;
-    }
-
-    // Distance matrix
-    long dist[ir1_size+1][ir2_size+1];
-    // Fill 1st column and row
-    for(long i = 0; i < ir1_size; ++i) {
-        dist[i][0] = i;
-    }
-    for(long i = 0; i < ir2_size; ++i) {
-        dist[0][i] = i;
-    }
 
+        std::vector<uint64_t> eq(text_size);
+        // Horizontal delta (-1, 0, 1) entering the block in each column, 1st row is 0, 1, 2...
+        std::vector<int8_t> hin(text_size, 1);
+        std::vector<uint64_t> sym_mask(symbols, 0);
+        std::vector<uint32_t> block_syms;
+        const size_t blocks = (pattern_size+63) / 64;
+        size_t dist = pattern_size;
+
+        for(size_t b = 0; b < blocks; ++b) {
+            const size_t start = b*64;
+            const size_t len = std::min<size_t>(64, pattern_size - start);
+            // Match masks for this block
+            uint64_t wild = 0;
+            block_syms.clear();
+            for(size_t k = 0; k < len; ++k) {
+                auto s = pattern[start+k];
+                if(s == WILDCARD) {
+                    wild |= 1ULL << k;
+                }
+                else if(s < symbols) {
+                    if(sym_mask[s] == 0) {
+                        block_syms.push_back(s);
+                    }
+                    sym_mask[s] |= 1ULL << k;
+                }
+            }
+            for(size_t j = 0; j < text_size; ++j) {
+                eq[j] = text[j] == WILDCARD ? ~0ULL : wild;
+            }
+            for(auto s: block_syms) {
+                for(size_t o = occ_start[s]; o < occ_start[s+1]; ++o) {
+                    eq[occ[o]] |= sym_mask[s];
+                }
+                sym_mask[s] = 0;
+            }
 
-    for(long j = 1; j < ir2_size; ++j) {
-        for(long i = 1; i < ir1_size; ++i) {
-            long cost = 1;
-            if(*ir1_v[i-1] == *ir2_v[j-1] || ir1_v[i-1]->type == IR::Type::EXPRESSION || 
-                ir2_v[j-1]->type == IR::Type::EXPRESSION) {
-                cost = 0;
+            // Only lower bits are used in the last block, higher ones never affect them
+            const bool last = b == blocks-1;
+            const unsigned out_bit = len-1;
+            uint64_t pv = ~0ULL;
+            uint64_t mv = 0;
+            for(size_t j = 0; j < text_size; ++j) {
+                uint64_t e = eq[j];
+                const uint64_t hin_neg = hin[j] < 0 ? 1 : 0;
+                const uint64_t xv = e | mv;
+                e |= hin_neg;
+                const uint64_t xh = (((e & pv) + pv) ^ pv) | e;
+                uint64_t ph = mv | ~(xh | pv);
+                uint64_t mh = pv & xh;
+                const int hout = static_cast<int>((ph >> out_bit) & 1) - static_cast<int>((mh >> out_bit) & 1);
+                ph = (ph << 1) | (hin[j] > 0 ? 1 : 0);
+                mh = (mh << 1) | hin_neg;
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+                if(last) {
+                    dist += hout;
+                }
+                else {
+                    hin[j] = static_cast<int8_t>(hout);
+                }
             }
-            dist[i][j] = std::min({dist[i-1][j]+1, dist[i][j-1]+1, dist[i-1][j-1]+cost});
         }
+        return dist;
     }
 
-    auto max_l = std::max(ir1_size, ir2_size);
-    auto score = dist[ir1_size-1][ir2_size-1];
-    return (max_l-score)/static_cast<float>(max_l);
-}
-
-float Fitness::jaro(IR::Node *ir1, IR::Node *ir2) {
-    IR::Word nl(std::string("\n"), IR::Type::DELIMITER);
-
-    // Move IR into linear version
-    std::vector<IR::Word *> ir1_v;
-    auto ir1_line = ir1->nodes->begin();
-    const auto& ir1_end = ir1->nodes->end();
-    long ir1_size = 0;
-    while(ir1_line != ir1_end){
-        // Iterate words in lines
-        auto ir1_word = (*ir1_line)->begin();
-        const auto& ir1_word_end = (*ir1_line)->end();
-        while(ir1_word != ir1_word_end){
-            ir1_v.push_back(*ir1_word);
-            ir1_word = std::next(ir1_word);
-            ++ir1_size;
+    /**
+     * Levenshtein similarity of linearized texts
+     * @param ir1_v Target tokens
+     * @param ir2_v Compared text tokens
+     * @param symbols Amount of interned token IDs
+     */
+    float levenshtein_tokens(const std::vector<uint32_t> &ir1_v, const std::vector<uint32_t> &ir2_v, size_t symbols) {
+        size_t ir1_size = ir1_v.size();
+        size_t ir2_size = ir2_v.size();
+
+        if(ir1_size == 0 && ir2_size == 0) {
+            return 1.0f;
+        }
+        if(ir1_size == 0 || ir2_size == 0) {
+            return 0.0f;
         }
-        ir1_v.push_back(&nl);
-        ++ir1_size;
-        ir1_line = std::next(ir1_line);
-    }
 
-    std::vector<IR::Word *> ir2_v;
-    auto ir2_line = ir2->nodes->begin();
-    const auto& ir2_end = ir2->nodes->end();
-    long ir2_size = 0;
-    while(ir2_line != ir2_end){
-        // Iterate words in lines
-        auto ir2_word = (*ir2_line)->begin();
-        const auto& ir2_word_end = (*ir2_line)->end();
-        while(ir2_word != ir2_word_end){
-            ir2_v.push_back(*ir2_word);
-            ir2_word = std::next(ir2_word);
-            ++ir2_size;
+        // Last token (new line) is not part of the distance
+        // Distance is symmetric, so shorter sequence is used as pattern to use less blocks
+        size_t score;
+        if(ir1_size <= ir2_size) {
+            score = edit_distance(ir1_v, ir1_size-1, ir2_v, ir2_size-1, symbols);
+        }
+        else {
+            score = edit_distance(ir2_v, ir2_size-1, ir1_v, ir1_size-1, symbols);
         }
-        ir2_v.push_back(&nl);
-        ++ir2_size;
-        ir2_line = std::next(ir2_line);
-    }
 
-    if(ir1_size == 0 && ir2_size == 0) {
-        return 1.0f;
+        auto max_l = std::max(ir1_size, ir2_size);
+        return (max_l-score)/static_cast<float>(max_l);
     }
-    if(ir1_size == 0 || ir2_size == 0) {
-        return 0.0f;
-    }
-
-    long max_dist = std::floor(std::max(ir1_size, ir2_size) / 2) - 1;
-    long matches = 0;
 
-    std::vector<bool> ir1_hash(ir1_size);
-    std::vector<bool> ir2_hash(ir2_size);
+    /**
+     * Jaro similarity of linearized texts
+     * @param ir1_v Target tokens
+     * @param ir2_v Compared text tokens
+     */
+    float jaro_tokens(const std::vector<uint32_t> &ir1_v, const std::vector<uint32_t> &ir2_v) {
+        long ir1_size = ir1_v.size();
+        long ir2_size = ir2_v.size();
 
-    for(long i = 0; i < ir1_size; ++i) {
-        for(long j = std::max(0L, i - max_dist); j < std::min(ir2_size, i + max_dist + 1); ++j) {
-            if(!ir2_hash[j] && *ir1_v[i] == *ir2_v[j] 
-                || (!ir2_hash[j] && ir1_v[i]->type == IR::Type::EXPRESSION)
-                || (!ir2_hash[j] && ir2_v[j]->type == IR::Type::EXPRESSION)) {
-                ir1_hash[i] = true;
-                ir2_hash[j] = true;
-                ++matches;
-                break;
-            }
+        if(ir1_size == 0 && ir2_size == 0) {
+            return 1.0f;
+        }
+        if(ir1_size == 0 || ir2_size == 0) {
+            return 0.0f;
         }
-    }
 
-    if(matches == 0)
-        return 0.0f;
+        long max_dist = std::floor(std::max(ir1_size, ir2_size) / 2) - 1;
+        long matches = 0;
 
-    long transp = 0;
-    long index = 0;
+        std::vector<bool> ir1_hash(ir1_size);
+        std::vector<bool> ir2_hash(ir2_size);
 
-    for(long i = 0; i < ir1_size; ++i) {
-        if(ir1_hash[i]) {
-            while(!ir2_hash[index]) {
-                ++index;
-            }
-            if(*ir1_v[i] != *ir2_v[index] && ir1_v[i]->type != IR::Type::EXPRESSION && ir2_v[index]->type != IR::Type::EXPRESSION) {
-                ++transp;
+        for(long i = 0; i < ir1_size; ++i) {
+            for(long j = std::max(0L, i - max_dist); j < std::min(ir2_size, i + max_dist + 1); ++j) {
+                if(!ir2_hash[j] && match(ir1_v[i], ir2_v[j])) {
+                    ir1_hash[i] = true;
+                    ir2_hash[j] = true;
+                    ++matches;
+                    break;
+                }
             }
-            ++index;
         }
-    }
 
-    float jaro_d = (static_cast<float>(matches) / static_cast<float>(ir1_size)
-                 + static_cast<float>(matches) / static_cast<float>(ir2_size)
-                 + (static_cast<float>(matches) - (transp / 2.0f)) / (static_cast<float>(matches))) 
-                 / 3.0f;
-    return jaro_d;
-}
-
-float Fitness::jaro_winkler(IR::Node *ir1, IR::Node *ir2) {
-    const static float THRESHOLD = 0.70f; 
-    const static long MIN_PREFIX = 4;
-    
-    IR::Word nl(std::string("\n"), IR::Type::DELIMITER);
+        if(matches == 0)
+            return 0.0f;
 
-    // Move IR into linear version
-    std::vector<IR::Word *> ir1_v;
-    auto ir1_line = ir1->nodes->begin();
-    const auto& ir1_end = ir1->nodes->end();
-    long ir1_size = 0;
-    while(ir1_line != ir1_end){
-        // Iterate words in lines
-        auto ir1_word = (*ir1_line)->begin();
-        const auto& ir1_word_end = (*ir1_line)->end();
-        while(ir1_word != ir1_word_end){
-            ir1_v.push_back(*ir1_word);
-            ir1_word = std::next(ir1_word);
-            ++ir1_size;
-        }
-        ir1_v.push_back(&nl);
-        ++ir1_size;
-        ir1_line = std::next(ir1_line);
-    }
+        long transp = 0;
+        long index = 0;
 
-    std::vector<IR::Word *> ir2_v;
-    auto ir2_line = ir2->nodes->begin();
-    const auto& ir2_end = ir2->nodes->end();
-    long ir2_size = 0;
-    while(ir2_line != ir2_end){
-        // Iterate words in lines
-        auto ir2_word = (*ir2_line)->begin();
-        const auto& ir2_word_end = (*ir2_line)->end();
-        while(ir2_word != ir2_word_end){
-            ir2_v.push_back(*ir2_word);
-            ir2_word = std::next(ir2_word);
-            ++ir2_size;
+        for(long i = 0; i < ir1_size; ++i) {
+            if(ir1_hash[i]) {
+                while(!ir2_hash[index]) {
+                    ++index;
+                }
+                if(!match(ir1_v[i], ir2_v[index])) {
+                    ++transp;
+                }
+                ++index;
+            }
         }
-        ir2_v.push_back(&nl);
-        ++ir2_size;
-        ir2_line = std::next(ir2_line);
-    }
 
-    if(ir1_size == 0 && ir2_size == 0) {
-        return 1.0f;
-    }
-    if(ir1_size == 0 || ir2_size == 0) {
-        return 0.0f;
+        float jaro_d = (static_cast<float>(matches) / static_cast<float>(ir1_size)
+                     + static_cast<float>(matches) / static_cast<float>(ir2_size)
+                     + (static_cast<float>(matches) - (transp / 2.0f)) / (static_cast<float>(matches))) 
+                     / 3.0f;
+        return jaro_d;
     }
 
-    long max_dist = std::floor(std::max(ir1_size, ir2_size) / 2) - 1;
-    long matches = 0;
+    /**
+     * Jaro-Winkler similarity of linearized texts
+     * @param ir1_v Target tokens
+     * @param ir2_v Compared text tokens
+     */
+    float jaro_winkler_tokens(const std::vector<uint32_t> &ir1_v, const std::vector<uint32_t> &ir2_v) {
+        const static float THRESHOLD = 0.70f; 
+        const static long MIN_PREFIX = 4;
+
+        float jaro_d = jaro_tokens(ir1_v, ir2_v);
+        // Empty texts and no matches are also handled here
+        if(jaro_d < THRESHOLD || jaro_d >= 1.0f) {
+            return jaro_d;
+        }
 
-    std::vector<bool> ir1_hash(ir1_size);
-    std::vector<bool> ir2_hash(ir2_size);
+        // Jaro-Winkler part
+        long prefix = 0;
+        long min_size = std::min(ir1_v.size(), ir2_v.size());
 
-    for(long i = 0; i < ir1_size; ++i) {
-        for(long j = std::max(0L, i - max_dist); j < std::min(ir2_size, i + max_dist + 1); ++j) {
-            if(!ir2_hash[j] && *ir1_v[i] == *ir2_v[j] 
-                || (!ir2_hash[j] && ir1_v[i]->type == IR::Type::EXPRESSION)
-                || (!ir2_hash[j] && ir2_v[j]->type == IR::Type::EXPRESSION)) {
-                ir1_hash[i] = true;
-                ir2_hash[j] = true;
-                ++matches;
+        for(long i = 0; i < min_size; ++i) {
+            if(match(ir1_v[i], ir2_v[i])) {
+                ++prefix;
+            }
+            else {
                 break;
             }
         }
-    }
 
-    if(matches == 0)
-        return 0.0f;
+        prefix = std::min(MIN_PREFIX, prefix);
 
-    long transp = 0;
-    long index = 0;
+        float jaro_wink_d = jaro_d + 0.1 * prefix * (1 - jaro_d);
+        return jaro_wink_d;
+    }
+}
 
-    for(long i = 0; i < ir1_size; ++i) {
-        if(ir1_hash[i]) {
-            while(!ir2_hash[index]) {
-                ++index;
-            }
-            if(*ir1_v[i] != *ir2_v[index] && ir1_v[i]->type != IR::Type::EXPRESSION && ir2_v[index]->type != IR::Type::EXPRESSION) {
-                ++transp;
+Target::Target(IR::Node *ir, float (*fit_fun)(IR::Node *, IR::Node *)) : doc(*ir), ir(ir), fit_fun(fit_fun) {
+    static const std::string nl("\n");
+    interned_ids.assign(IR::Word::TOKENS, UNKNOWN);
+    auto id_of = [this](std::string_view text) {
+        auto id = ids.emplace(text, static_cast<uint32_t>(ids.size())).first->second;
+        // Same text interned with any type is the same token
+        for(int type = 0; type <= IR::Type::DERIVED; ++type) {
+            auto token = IR::Word::intern(static_cast<IR::Type>(type), text);
+            if(token != IR::Word::NO_TOKEN) {
+                interned_ids[token] = id;
             }
-            ++index;
         }
+        return id;
+    };
+    const auto nl_id = id_of(nl);
+    tokens.reserve(doc.get_words_count() + doc.get_lines_count());
+    for(size_t line = 0; line < doc.get_lines_count(); ++line) {
+        for(size_t word = doc.line_begin(line); word < doc.line_end(line); ++word) {
+            auto type = doc.type(word);
+            tokens.push_back(type == IR::Type::EXPRESSION ? WILDCARD : id_of(doc.text(word)));
+        }
+        tokens.push_back(nl_id);
     }
+}
 
-    float jaro_d = (static_cast<float>(matches) / static_cast<float>(ir1_size)
-                 + static_cast<float>(matches) / static_cast<float>(ir2_size)
-                 + (static_cast<float>(matches) - (transp / 2.0f)) / (static_cast<float>(matches))) 
-                 / 3.0f;
-
-    if(jaro_d < THRESHOLD || jaro_d >= 1.0f) {
-        return jaro_d;
+void Target::linearize(IR::Node *text, std::vector<uint32_t> &out) const {
+    static const std::string nl("\n");
+    const auto nl_id = ids.at(nl);
+    for(auto const &line: *(text->nodes)) {
+        for(auto const &word: *line) {
+            if(word->get_type() == IR::Type::EXPRESSION) {
+                out.push_back(WILDCARD);
+            }
+            else if(word->get_token() != IR::Word::NO_TOKEN) {
+                // Interned words don't need hashing
+                out.push_back(interned_ids[word->get_token()]);
+            }
+            else {
+                auto id = ids.find(word->get_text());
+                out.push_back(id == ids.end() ? UNKNOWN : id->second);
+            }
+        }
+        out.push_back(nl_id);
     }
+}
 
-    // Jaro-Winkler part
-    long prefix = 0;
-
-    for(long i = 0; i < std::min(ir1_size, ir2_size); ++i) {
-        if(*ir1_v[i] == *ir2_v[i] || ir1_v[i]->type == IR::Type::EXPRESSION || ir2_v[i]->type == IR::Type::EXPRESSION) {
-            ++prefix;
+float Target::compare(IR::Node *text) const {
+    if(fit_fun == &levenshtein || fit_fun == &jaro || fit_fun == &jaro_winkler) {
+        std::vector<uint32_t> text_v;
+        linearize(text, text_v);
+        if(fit_fun == &levenshtein) {
+            return levenshtein_tokens(tokens, text_v, ids.size());
         }
-        else {
-            break;
+        if(fit_fun == &jaro) {
+            return jaro_tokens(tokens, text_v);
         }
+        return jaro_winkler_tokens(tokens, text_v);
     }
+    // Functions working on IR structure
+    return fit_fun(ir, text);
+}
 
-    prefix = std::min(MIN_PREFIX, prefix);
+float Fitness::levenshtein(IR::Node *ir1, IR::Node *ir2) {
+    return Target(ir1, &levenshtein).compare(ir2);
+}
+
+float Fitness::jaro(IR::Node *ir1, IR::Node *ir2) {
+    return Target(ir1, &jaro).compare(ir2);
+}
 
-    float jaro_wink_d = jaro_d + 0.1 * prefix * (1 - jaro_d);
-    return jaro_wink_d;
+float Fitness::jaro_winkler(IR::Node *ir1, IR::Node *ir2) {
+    return Target(ir1, &jaro_winkler).compare(ir2);
 }
@@ -12,11 +12,61 @@
 #ifndef _FITNESS_HPP_
 #define _FITNESS_HPP_
 
+#include <cstdint>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
 #include "ir.hpp"
+#include "document.hpp"
 #include "exceptions.hpp"
 
 /** Fitness functions */
 namespace Fitness {
+    /** Token ID for expressions, which match any other token */
+    const uint32_t WILDCARD = UINT32_MAX;
+    /** Token ID for words which are not in the target, these match nothing */
+    const uint32_t UNKNOWN = UINT32_MAX - 1;
+
+    /**
+     * Target text for fitness calculation
+     * Words of the target are interned by their text (as in Word comparison in fitness
+     * functions, type does not matter) into 32-bit token IDs and the text is linearized 
+     * (lines are ended with new line token) only once. Comparison with a text then
+     * only looks up text's words and compares integers.
+     * @note Target has to live only as long as its IR and the IR must not be modified
+     * @note Compare does not modify target, so it can be called from multiple threads
+     */
+    class Target {
+    private:
+        IR::Document doc;                                          ///< Target text, ids view into it
+        std::unordered_map<std::string_view, uint32_t> ids;       ///< Token ID of each word's text in target
+        std::vector<uint32_t> interned_ids;                        ///< Token ID for each interned word (Word::token)
+        std::vector<uint32_t> tokens;                              ///< Linearized target
+        IR::Node *ir;                                              ///< Target IR
+        float (*fit_fun)(IR::Node *, IR::Node *);                  ///< Fitness function used by compare
+    public:
+        /**
+         * Constructor
+         * @param ir Target IR
+         * @param fit_fun Fitness function to be used for comparisons
+         */
+        Target(IR::Node *ir, float (*fit_fun)(IR::Node *, IR::Node *));
+
+        /**
+         * Converts IR into linear vector of target's token IDs
+         * Words not present in the target are UNKNOWN and expressions are WILDCARD
+         * @param text IR to convert
+         * @param out Vector to push IDs into
+         */
+        void linearize(IR::Node *text, std::vector<uint32_t> &out) const;
+
+        /**
+         * Computes fitness of text compared to the target
+         * @param text IR to compare
+         * @return How much are the target and text similar where 1.0 is identical
+         */
+        float compare(IR::Node *text) const;
+    };
     /**
      * @brief One-to-one mapping 
      * Files are compared word by word in a single pass.
@@ -31,6 +81,8 @@ namespace Fitness {
      * @brief Levenshtein distance 
      * Files are compared using Levenshtein distance algorithm
      * Original algorithm - http://www.mathnet.ru/php/archive.phtml?wshow=paper&jrnid=dan&paperid=31411&option_lang=eng
+     * Distance is computed using bit-parallel algorithm (Myers, Hyyro) in O(n*m/64) time
+     * and linear memory.
      * @param ir1 IR of first file
      * @param ir2 IR of second file
      * @return How much are the 2 file similar where 1.0 is identical
@@ -0,0 +1,68 @@
+/**
+ * @file document.cpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Columnar text representation
+ *
+ * Read-only text stored in contiguous arrays instead of lists of words.
+ */
+
+#include "document.hpp"
+#include "arg_parser.hpp"
+
+using namespace IR;
+
+Document::Document() : offsets{0}, line_starts{0}, longest_line{0} {
+
+}
+
+Document::Document(const Node &node) : Document() {
+    size_t words = 0;
+    for(auto const &line: *(node.nodes)) {
+        words += line->size();
+    }
+    offsets.reserve(words + 1);
+    types.reserve(words);
+    line_starts.reserve(node.nodes->size() + 1);
+    for(auto const &line: *(node.nodes)) {
+        if(line == node.longest_line) {
+            longest_line = get_lines_count();
+        }
+        push_back(*line);
+    }
+}
+
+void Document::push_back(const std::list<Word *> &line) {
+    for(auto const *word: line) {
+        buffer += word->get_text();
+        offsets.push_back(buffer.size());
+        types.push_back(static_cast<uint8_t>(word->get_type()));
+    }
+    line_starts.push_back(types.size());
+}
+
+Node *Document::to_node() const {
+    auto node = new Node();
+    for(size_t line = 0; line < get_lines_count(); ++line) {
+        auto words = new std::list<Word *>();
+        for(size_t word = line_begin(line); word < line_end(line); ++word) {
+            words->push_back(new Word(std::string(text(word)), type(word)));
+        }
+        node->push_back(words);
+        if(line == longest_line) {
+            node->longest_line = words;
+        }
+    }
+    return node;
+}
+
+void Document::output(std::ostream &out) const {
+    for(size_t line = 0; line < get_lines_count(); ++line) {
+        // Words of a line are next to each other in the buffer
+        size_t begin = offsets[line_begin(line)];
+        out.write(buffer.data() + begin, offsets[line_end(line)] - begin);
+        out << Args::arg_opts.line_delim;
+    }
+}
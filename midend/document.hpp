@@ -0,0 +1,101 @@
+/**
+ * @file document.hpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Columnar text representation
+ *
+ * Read-only text stored in contiguous arrays instead of lists of words.
+ */
+
+#ifndef _DOCUMENT_HPP_
+#define _DOCUMENT_HPP_
+
+#include <cstdint>
+#include <list>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ir.hpp"
+
+namespace IR {
+
+    /**
+     * Text stored column by column (structure of arrays)
+     * All words are in one character buffer, words are described by their offsets
+     * and types and lines by index of their first word.
+     * Document is meant for texts which are only read many times (input and output examples),
+     * IR::Node is used for texts which are interpreted. Conversion to and from IR::Node
+     * is provided, so code working with IR::Node can be used as well.
+     */
+    class Document {
+    private:
+        std::string buffer;                ///< Text of all words one after another
+        std::vector<size_t> offsets;       ///< Offset of each word in buffer, last value is the buffer size
+        std::vector<uint8_t> types;        ///< Type (IR::Type) of each word
+        std::vector<size_t> line_starts;   ///< Index of the first word of each line, last value is words count
+        size_t longest_line;               ///< Index of the longest line
+    public:
+        /** Constructor of an empty document */
+        Document();
+        /**
+         * Constructs document from IR
+         * @param node IR to convert
+         */
+        Document(const Node &node);
+
+        /**
+         * Appends line at the end of the document
+         * @param line Line to append
+         */
+        void push_back(const std::list<Word *> &line);
+
+        /**
+         * Converts document to IR
+         * @return Newly allocated IR with the same text
+         */
+        Node *to_node() const;
+
+        /**
+         * Writes document in the output format for user
+         * @param out Stream to write to
+         */
+        void output(std::ostream &out) const;
+
+        /** @return Amount of lines */
+        size_t get_lines_count() const { return line_starts.size() - 1; }
+        /** @return Amount of words in all lines */
+        size_t get_words_count() const { return types.size(); }
+        /** @return Index of the longest line (the first one if there are more) */
+        size_t get_longest_line() const { return longest_line; }
+
+        /**
+         * @param line Line index
+         * @return Index of the first word of the line
+         */
+        size_t line_begin(size_t line) const { return line_starts[line]; }
+        /**
+         * @param line Line index
+         * @return Index after the last word of the line
+         */
+        size_t line_end(size_t line) const { return line_starts[line+1]; }
+
+        /**
+         * @param word Word index
+         * @return Text of the word
+         */
+        std::string_view text(size_t word) const {
+            return std::string_view(buffer.data() + offsets[word], offsets[word+1] - offsets[word]);
+        }
+        /**
+         * @param word Word index
+         * @return Type of the word
+         */
+        Type type(size_t word) const { return static_cast<Type>(types[word]); }
+    };
+
+}
+
+#endif//_DOCUMENT_HPP_
@@ -15,12 +15,18 @@
 #include <sstream>
 #include <string>
 #include <iterator>
+#include <algorithm>
 #include "ir.hpp"
+#include "document.hpp"
 #include "instruction.hpp"
+#include "symbol_table.hpp"
+#include "expr_kernel.hpp"
 #include "compiler.hpp"
 #include "arg_parser.hpp"
 #include "rng.hpp"
 #include "logging.hpp"
+#include "pool.hpp"
+#include "exceptions.hpp"
 
 #include <iostream>
 
@@ -50,34 +56,70 @@ Word::Word(std::string text,
            Expr::Expression *expr, 
            IR::PassExpression *code, 
            Inst::Instruction *return_inst) 
-          : text{text}, type{type}, expr{expr}, code{code}, return_inst{return_inst} {
-
+          : text{std::move(text)}, type{type} {
+    this->token = intern(this->type, this->text);
+    if(expr != nullptr || code != nullptr || return_inst != nullptr) {
+        this->expr_info = new ExprInfo{expr, code, return_inst};
+    }
 }
 
 Word::Word(const Word &other){
     this->text = other.text;
     this->type = other.type;
+    this->token = other.token;
     // TODO: Consider copying the expression as well
-    this->expr = nullptr;
-    this->code = nullptr;
-    this->return_inst = nullptr;
+    this->expr_info = nullptr;
 }
 
 Word::~Word() {
-    if(this->expr != nullptr) {
-        delete this->expr;
+    if(this->expr_info != nullptr) {
+        if(this->expr_info->expr != nullptr) {
+            delete this->expr_info->expr;
+        }
+        delete this->expr_info->code;
+        // Don't delete return_inst
+        delete this->expr_info;
+    }
+}
+
+/** Pool of words for current thread */
+static thread_local Utils::FixedPool<sizeof(Word)> word_pool;
+
+void *Word::operator new(size_t size) {
+    if(size != sizeof(Word)) {
+        // Objects of other sizes (derived classes) do not fit into the pool slots
+        return ::operator new(size);
+    }
+    return word_pool.allocate();
+}
+
+void Word::operator delete(void *ptr, size_t size) {
+    if(ptr == nullptr) {
+        return;
     }
-    delete code;
-    // Don't delete return_inst
+    if(size != sizeof(Word)) {
+        ::operator delete(ptr);
+        return;
+    }
+    word_pool.release(ptr);
+}
+
+bool Word::release_pools() {
+    return Utils::FixedPool<sizeof(Word)>::release_all();
 }
 
 Word& Word::operator=(const Word &other){
     this->text = other.text;
     this->type = other.type;
+    this->token = other.token;
     return *this;
 }
 
 bool Word::operator==(const Word &other) const {
+    if(this->token != NO_TOKEN || other.token != NO_TOKEN) {
+        // Interned word can only be equal to the same interned word
+        return this->token == other.token;
+    }
     return this->type == other.type && this->text == other.text;
 }
 
@@ -85,8 +127,16 @@ bool Word::operator!=(const Word &other) const {
     return !(*this == other);
 }
 
+bool Word::same_text(const Word &other) const {
+    if(this->token != NO_TOKEN && other.token != NO_TOKEN) {
+        // Interned words are one character long, compare the characters
+        return (this->token - 1) % 256 == (other.token - 1) % 256;
+    }
+    return this->text == other.text;
+}
+
 template <> int Word::to_int<IR::Type::NUMBER>() {
-    return Cast::to<int>(this->text.c_str());
+    return Cast::to<int>(this->text);
 }
 
 template <> float Word::to_float<IR::Type::FLOAT>() {
@@ -110,6 +160,7 @@ Node::~Node() {
 
 Node::Node(const Node &other){
     this->nodes = new std::list<std::list<Word *> *>();
+    this->longest_line = nullptr;
     for(const auto &line: *(other.nodes)){
         auto line_list = new std::list<Word *>();
         for(const auto &word: *line){
@@ -137,6 +188,57 @@ Node &Node::operator=(const Node &other){
     return *this;
 }
 
+void Node::reset(const Document &doc) {
+    // Words left over from previous lines, to be reused in following ones
+    std::vector<Word *> spare;
+    this->longest_line = nullptr;
+    auto line = this->nodes->begin();
+    for(size_t doc_line = 0; doc_line < doc.get_lines_count(); ++doc_line){
+        if(line == this->nodes->end()) {
+            // Line was deleted
+            line = this->nodes->insert(line, new std::list<Word *>());
+        }
+        auto word = (*line)->begin();
+        for(size_t doc_word = doc.line_begin(doc_line); doc_word < doc.line_end(doc_line); ++doc_word){
+            Word *target;
+            if(word != (*line)->end()) {
+                target = *word;
+                ++word;
+            }
+            else if(!spare.empty()) {
+                target = spare.back();
+                spare.pop_back();
+                (*line)->push_back(target);
+            }
+            else {
+                target = new Word("", IR::Type::EMPTY);
+                (*line)->push_back(target);
+            }
+            target->set(doc.text(doc_word), doc.type(doc_word));
+        }
+        // Words which are not in the original line anymore
+        while(word != (*line)->end()) {
+            spare.push_back(*word);
+            word = (*line)->erase(word);
+        }
+        if(doc_line == doc.get_longest_line()) {
+            this->longest_line = *line;
+        }
+        ++line;
+    }
+    // Remove lines which are not in the original
+    while(line != this->nodes->end()) {
+        for(auto const &word: **line){
+            delete word;
+        }
+        delete *line;
+        line = this->nodes->erase(line);
+    }
+    for(auto word: spare) {
+        delete word;
+    }
+}
+
 bool Node::operator==(const Node &other) const {
     // Get start and end iterators
     auto start1 = this->nodes->begin();
@@ -182,8 +284,12 @@ void Node::push_back(unsigned long line, Word *value){
         // Create new nodes until requested line is created
         this->nodes->push_back(new std::list<Word *>());
     }
-    auto index_line = this->nodes->begin();
-    std::advance(index_line, line);
+    // Words are mostly appended to the last line, so avoid walking the whole text for it
+    auto index_line = std::prev(this->nodes->end());
+    if(line + 1 != this->nodes->size()) {
+        index_line = this->nodes->begin();
+        std::advance(index_line, line);
+    }
     (*index_line)->push_back(value);
     if(this->longest_line == nullptr || (*index_line)->size() > this->longest_line->size()) {
         this->longest_line = (*index_line);
@@ -200,13 +306,17 @@ void Node::push_back(std::list<Word *> *line){
 
 std::string Node::output(){
     std::stringstream out;
+    this->output(out);
+    return out.str();
+}
+
+void Node::output(std::ostream &out){
     for(auto const& line: *(this->nodes)){
         for(auto const *word: *line){
-            out << word->text;
+            out << word->get_text();
         }
         out << Args::arg_opts.line_delim;
     }
-    return out.str();
 }
 
 Pass::Pass(PassType type) : type{type}, env{}, subpass_table{nullptr}, last_executed_index{-1} {
@@ -285,44 +395,207 @@ void Pass::set_pipeline(std::vector<Inst::Instruction *> *pipeline) {
 
 PassExpression::PassExpression(IR::Type expr_type) : Pass(PassType::EXPRESSION_PASS),
                                                      expr_type{expr_type},
-                                                     match{} {
+                                                     match{},
+                                                     sym_table{nullptr},
+                                                     kernels{},
+                                                     compiled_size{0},
+                                                     deferrable{false},
+                                                     failures{0} {
 
 }
 
 PassExpression::PassExpression(IR::Type expr_type, std::string match) : Pass(PassType::EXPRESSION_PASS),
                                                                         expr_type{expr_type},
-                                                                        match{match} {
+                                                                        match{match},
+                                                                        sym_table{nullptr},
+                                                                        kernels{},
+                                                                        compiled_size{0},
+                                                                        deferrable{false},
+                                                                        failures{0} {
 
 }
 
 PassExpression::PassExpression(const PassExpression &other) : Pass(other),
                                                               expr_type{other.expr_type},
-                                                              match{other.match} {
+                                                              match{other.match},
+                                                              sym_table{nullptr},
+                                                              kernels{},
+                                                              compiled_size{0},
+                                                              deferrable{false},
+                                                              failures{0} {
     
 }
 
+PassExpression::~PassExpression() {
+    delete sym_table;
+    for(auto kernel: kernels) {
+        delete kernel;
+    }
+}
+
+void PassExpression::compile() {
+    for(int type = 0; type <= IR::Type::DERIVED; ++type) {
+        delete kernels[type];
+        kernels[type] = nullptr;
+        // Typed pass gets only words of its type, others can get any word
+        if(expr_type != type && expr_type != IR::Type::DERIVED && expr_type != IR::Type::MATCH) {
+            continue;
+        }
+        auto input = Vars::SymbolTable::var0_type(static_cast<IR::Type>(type));
+        auto kernel = new Inst::ExprKernel();
+        if(input != IR::Type::DERIVED && kernel->compile(input, *this->pipeline, Args::arg_opts.sym_table_size)) {
+            kernels[type] = kernel;
+        }
+        else {
+            delete kernel;
+        }
+        LOG4("Expression pass for " << IR::get_type_name(static_cast<IR::Type>(type)) << " "
+             << (kernels[type] ? "compiled" : "will be interpreted"));
+    }
+    compiled_size = Args::arg_opts.sym_table_size;
+    // Only words of pass type are deferred
+    deferrable = (expr_type == IR::Type::NUMBER || expr_type == IR::Type::FLOAT)
+                 && kernels[expr_type] != nullptr && !kernels[expr_type]->can_fail();
+}
+
+bool PassExpression::is_deferrable() {
+    if(compiled_size != Args::arg_opts.sym_table_size) {
+        this->compile();
+    }
+    return deferrable;
+}
+
+void PassExpression::defer(IR::Word *word) {
+    deferred.push_back(word);
+    if(deferred.size() == Inst::ExprKernel::COLUMN_SIZE) {
+        this->flush();
+    }
+}
+
+void PassExpression::flush() {
+    if(deferred.empty()) {
+        return;
+    }
+    Inst::ExprKernel::Value values[Inst::ExprKernel::COLUMN_SIZE];
+    const size_t count = deferred.size();
+    auto kernel = kernels[expr_type];
+    for(size_t i = 0; i < count; ++i) {
+        values[i] = kernel->read(deferred[i]);
+    }
+    kernel->exec_column(values, count);
+    for(size_t i = 0; i < count; ++i) {
+        kernel->write(deferred[i], values[i]);
+    }
+    deferred.clear();
+}
+
 void PassExpression::process(IR::Node *text) {
 
 }
 
 void PassExpression::process(IR::Word *word, size_t line, size_t column) {
-    auto sym_table = new Vars::SymbolTable(word);
-    try {
-        for(auto inst: (*this->pipeline)){
-            ++line;
-            inst->exec(sym_table);
+    // Symbol table size can be changed by a pragma after the pass was created
+    if(compiled_size != Args::arg_opts.sym_table_size) {
+        this->compile();
+    }
+    auto kernel = kernels[word->get_type()];
+    if(kernel != nullptr) {
+        kernel->load(word);
+        if(kernel->exec()) {
+            kernel->store(word);
+        }
+        else {
+            this->fail(word, line, column, 0, nullptr);
         }
-        word->type = sym_table->type_at(0);
-        word->text = sym_table->to_string(0);
+        return;
+    }
+    size_t position = 0;
+    try {
+        this->interpret(word, position);
+    } catch (Exception::EbeException *e) {
+        this->fail(word, line, column, position, e);
+    } catch (Exception::EbeException &e) {
+        this->fail(word, line, column, position, &e);
+    }
+}
+
+void PassExpression::interpret(IR::Word *word, size_t &position) {
+    if(sym_table == nullptr || sym_table->get_size() != Args::arg_opts.sym_table_size) {
+        delete sym_table;
+        sym_table = new Vars::SymbolTable();
+    }
+    sym_table->reset(word);
+    for(auto inst: (*this->pipeline)){
+        ++position;
+        inst->exec(sym_table);
+    }
+    word->set(sym_table->to_string(0), sym_table->type_at(0));
+}
+
+void PassExpression::fail(IR::Word *word, size_t line, size_t column, size_t position, Exception::EbeException *exc) {
+    ++failures;
+    if(samples.size() >= Args::arg_opts.error_samples || Args::arg_opts.no_error_print) {
+        return;
+    }
+    if(exc != nullptr) {
+        samples.push_back(Failure{word->get_text(), line, column, position, exc->get_type(), exc->what()});
+        return;
+    }
+    // Compiled code does not know why it failed, generic interpretation (of a copy,
+    // so that the word stays unmodified) gives the same error as without compilation
+    IR::Word copy(word->get_text(), word->get_type());
+    try {
+        this->interpret(&copy, position);
     } catch (Exception::EbeException *e) {
-        Error::error(Error::ErrorCode::RUNTIME, (std::string("Word '")+word->text+"' (line "+std::to_string(line)
-            +", column "+ std::to_string(column) +") won't be modified").c_str(), e, false);
+        samples.push_back(Failure{word->get_text(), line, column, position, e->get_type(), e->what()});
     } catch (Exception::EbeException &e) {
-        Error::error(Error::ErrorCode::RUNTIME, (std::string("Word '")+word->text+"' (line "+std::to_string(line)
-            +", column "+ std::to_string(column) +") won't be modified").c_str(), &e, false);
+        samples.push_back(Failure{word->get_text(), line, column, position, e.get_type(), e.what()});
     }
 }
 
+namespace {
+    /** Exception of a failed word, which is reported after interpretation */
+    class ReportedFailure : public Exception::EbeException {
+    public:
+        ReportedFailure(const std::string &msg, const char *type) : EbeException(msg, type) {}
+    };
+}
+
+void PassExpression::report_failures(const std::vector<PassExpression *> &copies, const std::string &name, const char *file_name) {
+    size_t total = failures;
+    std::vector<Failure> reported;
+    reported.swap(samples);
+    failures = 0;
+    for(auto copy: copies) {
+        total += copy->failures;
+        reported.insert(reported.end(), copy->samples.begin(), copy->samples.end());
+        copy->failures = 0;
+        copy->samples.clear();
+    }
+    if(total == 0) {
+        return;
+    }
+    // Every worker keeps its first failures, so the first failures in the text are among them
+    std::stable_sort(reported.begin(), reported.end(), [](const Failure &a, const Failure &b) {
+        return a.line < b.line || (a.line == b.line && a.column < b.column);
+    });
+    if(reported.size() > Args::arg_opts.error_samples) {
+        reported.resize(Args::arg_opts.error_samples);
+    }
+    for(auto &failure: reported) {
+        ReportedFailure exc(failure.message, failure.type);
+        Error::error(Error::ErrorCode::RUNTIME, (std::string("Word '")+failure.text+"' (line "+std::to_string(failure.line+failure.position)
+            +", column "+ std::to_string(failure.column) +") won't be modified").c_str(), &exc, false);
+    }
+    std::string msg = name+" failed on "+std::to_string(total)+" "
+                      +(total == 1 ? "word in " : "words in ")+file_name
+                      +(total == 1 ? ", it was not modified" : ", they were not modified");
+    if(reported.size() < total) {
+        msg += " ("+std::to_string(reported.size())+" reported, use --error-samples to change it)";
+    }
+    Error::error(Error::ErrorCode::RUNTIME, msg.c_str(), nullptr, false);
+}
+
 PassWords::PassWords() : Pass(PassType::WORDS_PASS) {
 
 }
@@ -347,98 +620,182 @@ void PassWords::process(IR::Node *text) {
     }
     LOG4("Words pass processing:\n" << *text);
     //LOG5("Processing over: " << *this);
+    this->reset();
+    // Iterate through lines of text
+    size_t line_number = 0;
+    for(auto line: *(text->nodes)){
+        this->process_line(line, line_number);
+        ++line_number;
+    }
+    this->flush();
+    LOG4("Word pass processing done");
+}
+
+void PassWords::reset() {
     // Reset optimization variables
     this->last_executed_index = -1;
     // Reset environment
     env.reprocess_obj = false;
     env.loop_inst = nullptr;
-    // Iterate through lines of text
-    size_t line_number = 0;
-    for(auto line = (*text->nodes).begin(); line != (*text->nodes).end(); ++line){
-        ssize_t column = 0;
-        env.loop_inst = nullptr;
-        bool checked_executable_loop = false;  // Used to detect inf loops
-        auto word = (*line)->begin();
-        auto prev = word;
-        while(word != (*line)->end()) {
+    // Pipeline might have changed since the last text (GP), so compile it again
+    this->compile();
+}
+
+void PassWords::compile() {
+    const size_t size = this->pipeline->size();
+    code.resize(size);
+    bool executable = false;
+    for(size_t i = 0; i < size; ++i) {
+        Inst::Instruction *inst = (*this->pipeline)[i];
+        const char *name = inst->get_name();
+        CompiledInst &ci = code[i];
+        ci.inst = inst;
+        ci.subpass = nullptr;
+        ci.call_follows = false;
+        ci.after_calls = 0;
+        ci.executable_loop = executable;
+        ci.defer = false;
+        if(!inst->control) {
+            executable = true;
+        }
+        if(name == Inst::NOP::NAME || name == Inst::CONCAT::NAME) {
+            ci.kind = OpKind::SKIP;
+        }
+        else if(name == Inst::LOOP::NAME) {
+            ci.kind = OpKind::LOOP;
+        }
+        else if(name == Inst::CALL::NAME) {
+            ci.kind = OpKind::CALL;
+            auto index = dynamic_cast<Inst::CALL *>(inst)->get_arg1();
+            ci.subpass = dynamic_cast<PassExpression *>((*this->subpass_table)[index]);
+        }
+        else {
+            ci.kind = OpKind::EXEC;
+        }
+    }
+    // Deferred words must not be accessed before flush, which holds when every word is visited
+    // only once (no LOOP and no SWAP) and the word is not deleted right after the expression
+    bool deferring = std::all_of(code.begin(), code.end(), [](const CompiledInst &ci) {
+        return ci.kind != OpKind::LOOP && (ci.kind != OpKind::EXEC || ci.inst->get_name() == Inst::DEL::NAME);
+    });
+    // Resolve where to continue after a CALL (always followed by its return instruction)
+    for(size_t i = size; i-- > 0;) {
+        CompiledInst &ci = code[i];
+        if(ci.kind != OpKind::CALL) {
+            continue;
+        }
+        size_t next = i + 2;
+        ci.call_follows = next < size && code[next].kind == OpKind::CALL;
+        ci.after_calls = ci.call_follows ? code[next].after_calls : next;
+        ci.defer = deferring && i + 1 < size && code[i+1].kind == OpKind::SKIP && ci.subpass->is_deferrable();
+    }
+}
+
+bool PassWords::has_deferred() const {
+    return std::any_of(code.begin(), code.end(), [](const CompiledInst &ci) { return ci.defer; });
+}
+
+void PassWords::flush() {
+    for(auto &ci: code) {
+        if(ci.defer) {
+            ci.subpass->flush();
+        }
+    }
+}
+
+void PassWords::process(const std::vector<std::list<Word *> *> &lines, size_t line_number) {
+    for(auto line: lines) {
+        this->process_line(line, line_number++);
+    }
+    this->flush();
+}
+
+void PassWords::process_line(std::list<Word *> *line, size_t line_number) {
+    const size_t size = this->code.size();
+    if(size == 0){
+        return;
+    }
+    size_t column = 0;
+    size_t loop_column = 0;
+    env.loop_inst = nullptr;
+    bool checked_executable_loop = false;  // Used to detect inf loops
+    auto word = line->begin();
+    while(word != line->end()) {
+        if(column >= size){
             // Break when not looping and there are no more instructions for the line
-            if(!this->env.loop_inst && column >= this->pipeline->size()){
+            if(!this->env.loop_inst){
                 break;
             }
-            else if(this->env.loop_inst && column >= this->pipeline->size()){
-                // This control has to be here in case loop is the last instruction
-                column = 0;
-            }
-            Inst::Instruction *inst = (*this->pipeline)[column];
-            // To make sure loops are not executed on the first pass the loop control is before instruction execution
-            ++column;
-            if(this->env.loop_inst == inst || (this->env.loop_inst && column >= this->pipeline->size())){
-                // If it was not yet checked, make sure there are actual non-controll instructions in the loop
-                if(!checked_executable_loop){
-                    bool found = false;
-                    // Loop through previous instruction and check if any of them is non-controll and non-call
-                    for(auto i = pipeline->begin(); *i != this->env.loop_inst; ++i){
-                        if(!(*i)->control){
-                            // Found non-controll
-                            found = true;
-                            checked_executable_loop = true;
-                        }
-                    }
-                    if(!found){
-                        break;
-                    }
+            // This control has to be here in case loop is the last instruction
+            column = 0;
+        }
+        const CompiledInst *ci = &code[column];
+        // To make sure loops are not executed on the first pass the loop control is before instruction execution
+        ++column;
+        if(this->env.loop_inst && (this->env.loop_inst == ci->inst || column >= size)){
+            // If it was not yet checked, make sure there are actual non-controll instructions in the loop
+            if(!checked_executable_loop){
+                if(!code[loop_column].executable_loop){
+                    break;
                 }
-                // In a loop
-                column = 0;
+                checked_executable_loop = true;
             }
-            LOGMAX("Current instruction: " << inst->get_name() << "; Current word: " << **word);
-            // Check if instruction is subprocess call
-            if(inst->get_name() == std::string("CALL")){
-                auto index = dynamic_cast<Inst::CALL *>(inst)->get_arg1();
-                auto subpass = dynamic_cast<PassExpression *>((*this->subpass_table)[index]);
-                // Check if type matches pass type
-                if(subpass->expr_type == (*word)->type 
-                    || subpass->expr_type == IR::Type::DERIVED
-                    || (subpass->expr_type == IR::Type::MATCH && (*word)->text == subpass->match)) {
-                    // TODO: Calculate actual character column. Column here isn't letter column, but word number
-                    subpass->process(*word, line_number, column);
-                    // Execute return instruction (column was incemented before this)
-                    inst = (*this->pipeline)[column];
-                    inst->exec(word, *line, this->env);
-                    // Skip all following expressions since this one was executed
-                    ++column;
-                    while(column < this->pipeline->size() && (*this->pipeline)[column]->get_name() == std::string("CALL")) {
-                        column += 2; // Add 2 since its always a call + return
-                    }
+            // In a loop
+            column = 0;
+        }
+        LOGMAX("Current instruction: " << ci->inst->get_name() << "; Current word: " << **word);
+        switch(ci->kind) {
+        case OpKind::SKIP:
+            break;
+        case OpKind::LOOP:
+            this->env.loop_inst = ci->inst;
+            this->env.reprocess_obj = true;
+            loop_column = ci - code.data();
+            break;
+        case OpKind::CALL: {
+            PassExpression *subpass = ci->subpass;
+            // Check if type matches pass type
+            if(subpass->expr_type == (*word)->get_type() 
+                || subpass->expr_type == IR::Type::DERIVED
+                || (subpass->expr_type == IR::Type::MATCH && (*word)->get_text() == subpass->match)) {
+                // TODO: Calculate actual character column. Column here isn't letter column, but word number
+                if(ci->defer) {
+                    subpass->defer(*word);
                 }
                 else {
-                    // Skip return
-                    ++column;
-                    // Reprocess only if pass is following
-                    if(column < this->pipeline->size() && (*this->pipeline)[column]->get_name() == std::string("CALL")){
-                        env.reprocess_obj = true;
-                    }
-                    else {
-                        LOG1("Implicit NOP DERIVED pass added");
-                    }
+                    subpass->process(*word, line_number, column);
                 }
+                // Execute return instruction (column was incemented before this)
+                code[column].inst->exec(word, line, this->env);
+                // Skip all following expressions since this one was executed
+                column = ci->after_calls;
             }
             else {
-                // Instruction execution
-                inst->exec(word, *line, this->env);
-            }
-            if(!env.reprocess_obj){
-                ++word;
-            }
-            env.reprocess_obj = false;
-            // Save column if its bigger than biggest column number so far (for optimization)
-            if(static_cast<ssize_t>(column) > this->last_executed_index) {
-                this->last_executed_index = column;
+                // Skip return
+                ++column;
+                // Reprocess only if pass is following
+                if(ci->call_follows){
+                    env.reprocess_obj = true;
+                }
+                else {
+                    LOG1("Implicit NOP DERIVED pass added");
+                }
             }
+            break;
+        }
+        case OpKind::EXEC:
+            ci->inst->exec(word, line, this->env);
+            break;
+        }
+        if(!env.reprocess_obj){
+            ++word;
+        }
+        env.reprocess_obj = false;
+        // Save column if its bigger than biggest column number so far (for optimization)
+        if(static_cast<ssize_t>(column) > this->last_executed_index) {
+            this->last_executed_index = column;
         }
-        ++line_number;
     }
-    LOG4("Word pass processing done");
 }
 
 PassLines::PassLines() : Pass(PassType::LINES_PASS) {
@@ -602,10 +959,6 @@ void EbelNode::push_back(Pass *pass){
     this->nodes->push_back(pass);
 }
 
-bool operator==(IR::Word &lhs, IR::Word &rhs){
-    return lhs.text == rhs.text;
-}
-
 namespace IR {
     std::ostream& operator<< (std::ostream &out, const Node& node){
         static const std::set<char> NOT_PRINT{' ', '\t', '\v', '\f', '\n'};
@@ -620,15 +973,15 @@ namespace IR {
                 }
                 first = false;
                 // Print word's type and value
-                out << "(" << get_type_name(word->type) << ")";
-                if((word->type == IR::Type::DELIMITER || word->type == IR::Type::SYMBOL) && 
-                (!std::isprint(word->text[0]) || NOT_PRINT.find(word->text[0]) != NOT_PRINT.end())){
-                    for(auto c: word->text){
+                out << "(" << get_type_name(word->get_type()) << ")";
+                if((word->get_type() == IR::Type::DELIMITER || word->get_type() == IR::Type::SYMBOL) && 
+                (!std::isprint(word->get_text()[0]) || NOT_PRINT.find(word->get_text()[0]) != NOT_PRINT.end())){
+                    for(auto c: word->get_text()){
                         // For non printable or not visible charactets print hex value
                         out << "\\0x" << std::hex << static_cast<int>(c) << std::dec;
                     }
                 }else{
-                    out << word->text;
+                    out << word->get_text();
                 }
             }
             line_number++;
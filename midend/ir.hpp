@@ -15,6 +15,8 @@
 #include <list>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <ostream>
 #include "engine.hpp"
 #include "gp.hpp"
@@ -28,16 +30,25 @@
 namespace Inst {
     class Instruction;
     class ExprInstruction;
+    class ExprKernel;
 }
 
 namespace GP {
     class Population;
 }
 
+namespace Vars {
+    class SymbolTable;
+}
+
 namespace Pragma {
     class Pragmas;
 }
 
+namespace Exception {
+    class EbeException;
+}
+
 struct GPEngineParams;
 
 /**
@@ -47,6 +58,18 @@ namespace IR {
 
     // Forward declaration
     class PassExpression;
+    class Document;
+
+    /**
+     * Expression data of a word
+     * Only expression words in example files have these, so they are kept
+     * out of the word itself to keep words small
+     */
+    struct ExprInfo {
+        Expr::Expression *expr;           ///< Expression abstract syntax tree
+        IR::PassExpression *code;         ///< Code generated for the expression
+        Inst::Instruction *return_inst;   ///< Return instruction of the expression
+    };
 
     /**
      * Word datatypes - types for input text file
@@ -78,12 +101,15 @@ namespace IR {
     private:
         friend std::ostream& operator<< (std::ostream &out, const std::list<IR::Word>& node);
         friend std::ostream& operator<< (std::ostream &out, const IR::Word& word);
-    public:
+
         std::string text;                   ///< Text represantation of the word (as was in the file)
         Type type;                          ///< Type parsed type of the word
-        Expr::Expression *expr = nullptr;   ///< Expression abstract syntax tree if type is IR::Type EXPRESSION
-        IR::PassExpression *code = nullptr; ///< Code generated for the expression if type is IR::Type::EXPRESSION
-        Inst::Instruction *return_inst = nullptr; ///< Return instruction of the expression
+        uint32_t token;                     ///< Interned ID of text and type (see intern), kept in sync by set
+    public:
+        static const uint32_t NO_TOKEN = 0;                ///< Token ID of words which are not interned
+        static const uint32_t TOKENS = 1 + (DERIVED+1)*256; ///< Upper bound of interned token IDs
+
+        ExprInfo *expr_info = nullptr;      ///< Expression data if type is IR::Type::EXPRESSION, otherwise nullptr
 
         /**
          * Constructor 
@@ -103,13 +129,83 @@ namespace IR {
         /** Destructor, frees expr when allocated */
         ~Word();
 
+        /**
+         * @defgroup wordalloc Word allocation
+         * Words are allocated from a per thread pool, since texts consist of
+         * many small words that are frequently deleted (DEL, streamed lines).
+         * Only allocations of Word's size use the pool, others use global new/delete.
+         * @{
+         */
+        static void *operator new(size_t size);
+        static void operator delete(void *ptr, size_t size);
+        /**
+         * Returns memory of all threads' word pools to the system once no word is alive
+         * @note Has to be called when no other thread works with words (outside of worker pool batches)
+         * @return true if the memory was released
+         */
+        static bool release_pools();
+        /** @} */
+
         /** Copy operator */
         Word& operator=(const Word &other);
 
-        /** Comparison operator */
+        /**
+         * @defgroup wordexpr Expression data getters
+         * @return Expression data or nullptr if the word is not an expression
+         * @{
+         */
+        Expr::Expression *get_expr() const { return expr_info ? expr_info->expr : nullptr; }
+        IR::PassExpression *get_code() const { return expr_info ? expr_info->code : nullptr; }
+        Inst::Instruction *get_return_inst() const { return expr_info ? expr_info->return_inst : nullptr; }
+        /** @} */
+
+        /**
+         * @defgroup wordattrs Word attribute getters
+         * Text, type and token can be changed only together using set
+         * @{
+         */
+        const std::string &get_text() const { return this->text; }
+        Type get_type() const { return this->type; }
+        uint32_t get_token() const { return this->token; }
+        /** @} */
+
+        /**
+         * Interns text and type into a token ID
+         * One character delimiters and symbols (the most common words) have fixed IDs,
+         * so words can be compared by the ID without any shared table.
+         * @param type Word type
+         * @param text Word text
+         * @return Token ID or NO_TOKEN if such word is not interned
+         */
+        static uint32_t intern(Type type, std::string_view text) {
+            if(text.size() == 1 && (type == DELIMITER || type == SYMBOL)) {
+                return 1 + type*256 + static_cast<unsigned char>(text[0]);
+            }
+            return NO_TOKEN;
+        }
+
+        /**
+         * Sets word's text and type
+         * @param text New text
+         * @param type New type
+         */
+        void set(std::string_view text, Type type) {
+            this->text.assign(text);
+            this->type = type;
+            this->token = intern(type, text);
+        }
+
+        /** Comparison operator, words are equal when both type and text match */
         bool operator==(const Word &other) const;
         bool operator!=(const Word &other) const;
 
+        /**
+         * Compares only texts of words (type is ignored), as is done in fitness functions
+         * @param other Word to compare with
+         * @return true if both words have the same text
+         */
+        bool same_text(const Word &other) const;
+
         /**
          * @defgroup wordgetters Word value extractors
          * Extract values of specified type from the word
@@ -147,6 +243,15 @@ namespace IR {
         /** Copy operator */
         Node &operator=(const Node &other);
 
+        /**
+         * Resets node into the state of a document
+         * Lines and words already held by this node are reused and only overwritten,
+         * so that resetting an interpreted copy of the text does not need to allocate
+         * anything but the words and lines deleted by the interpretation.
+         * @param doc Document to copy the text from
+         */
+        void reset(const Document &doc);
+
         /** Comparison operator */
         bool operator==(const Node &other) const;
         bool operator!=(const Node &other) const;
@@ -171,6 +276,12 @@ namespace IR {
          */
         std::string output();
 
+        /**
+         * Writes IR in the output format for user
+         * @param out Stream to write to
+         */
+        void output(std::ostream &out);
+
         /** 
          * Getter for lines count 
          * @note size() is used because since C++11 complexity of size on std::list is
@@ -294,15 +405,131 @@ namespace IR {
         PassExpression(Type expr_type, std::string match);
         /** Copy constructor */
         PassExpression(const PassExpression &other);
+        ~PassExpression();
 
         void process(IR::Node *text) override;
+
+        /**
+         * Evaluates expression for a word
+         * Word, for which the expression fails, is not modified and the failure is only
+         * counted (and the first ones kept), to be reported by report_failures
+         * @param word Word to modify
+         * @param line Line number of the word
+         * @param column Column of the word
+         */
         void process(IR::Word *word, size_t line, size_t column);
+
+        /** @return Amount of words the expression failed on since the last report */
+        size_t get_failures() const { return failures; }
+
+        /**
+         * Reports words the expression failed on and resets the failure count
+         * First Args::arg_opts.error_samples failed words are reported each on its own
+         * and they are followed by the amount of all failed words.
+         * @param copies Copies of this pass used by other workers for the same text,
+         *               their failures are reported together with this pass and reset
+         * @param name Description of the pass in the program (for the message)
+         * @param file_name Name of the interpreted file
+         */
+        void report_failures(const std::vector<PassExpression *> &copies, const std::string &name, const char *file_name);
+
+        /**
+         * @return True if words can be processed with defer (compiled code which cannot fail)
+         */
+        bool is_deferrable();
+
+        /**
+         * Adds word to be processed by the next flush
+         * Words are processed in columns, so the word cannot be accessed until flush is called
+         * @param word Word to process
+         */
+        void defer(IR::Word *word);
+
+        /** Processes all deferred words */
+        void flush();
+    private:
+        /** Word the expression failed on */
+        struct Failure {
+            std::string text;        ///< Text of the word
+            size_t line;             ///< Line of the word
+            size_t column;           ///< Column of the word
+            size_t position;         ///< Position of the failed instruction (reported added to the line)
+            const char *type;        ///< Exception type
+            std::string message;     ///< Exception message
+        };
+
+        Vars::SymbolTable *sym_table;  ///< Symbol table reused for every processed word (allocated on first use)
+        Inst::ExprKernel *kernels[DERIVED+1];  ///< Type specialized code for each word type or nullptr when
+                                               ///< generic interpretation is used
+        int compiled_size;             ///< Symbol table size the pass was compiled for (0 when not compiled)
+        bool deferrable;               ///< Compiled code cannot fail and so words can be deferred
+        std::vector<Word *> deferred;  ///< Words waiting for flush
+        size_t failures;               ///< Amount of words the expression failed on
+        std::vector<Failure> samples;  ///< First failed words
+
+        /** Compiles pipeline into type specialized code for every word type the pass can get */
+        void compile();
+
+        /**
+         * Evaluates expression for a word using generic interpretation
+         * @param word Word to modify, it is not modified on failure
+         * @param position Increased for every executed instruction (position of the failed one on failure)
+         * @throw EbeException when the expression fails
+         */
+        void interpret(IR::Word *word, size_t &position);
+
+        /**
+         * Counts failed word and keeps it if it is one of the first ones
+         * @param word Word the expression failed on
+         * @param line Line of the word
+         * @param column Column of the word
+         * @param position Position of the failed instruction
+         * @param exc Exception of the failure or nullptr when it is not known (failed compiled code)
+         */
+        void fail(IR::Word *word, size_t line, size_t column, size_t position, Exception::EbeException *exc);
     };
 
     /**
      * Pass by word
      */
     class PassWords : public Pass {
+    private:
+        /** Dispatch kind of a compiled instruction */
+        enum class OpKind {
+            SKIP,   ///< Instruction without effect on a word (NOP and CONCAT)
+            LOOP,   ///< Loop instruction
+            CALL,   ///< Call of an expression subpass (followed by its return instruction)
+            EXEC    ///< Any other instruction, executed through its exec method
+        };
+
+        /**
+         * Pipeline instruction resolved once before processing,
+         * so that the per word loop does not have to inspect instruction names and types
+         */
+        struct CompiledInst {
+            OpKind kind;                ///< How to dispatch the instruction
+            Inst::Instruction *inst;    ///< Original instruction
+            PassExpression *subpass;    ///< Called subpass (CALL only)
+            bool call_follows;          ///< CALL is followed by another CALL (CALL only)
+            size_t after_calls;         ///< Column after skipping all following CALLs (CALL only)
+            bool executable_loop;       ///< Non-control instruction precedes this one (LOOP only)
+            bool defer;                 ///< Subpass evaluation can be deferred (CALL only)
+        };
+
+        std::vector<CompiledInst> code;  ///< Compiled pipeline, rebuilt in reset
+
+        /** Compiles pipeline into code */
+        void compile();
+
+        /**
+         * Processes one line of text through pipeline without flushing deferred expressions
+         * @param line Line to be processed
+         * @param line_number Number of the line in the text
+         */
+        void process_line(std::list<Word *> *line, size_t line_number);
+
+        /** Processes words deferred by expression subpasses */
+        void flush();
     public:
         /** Constructor */
         PassWords();
@@ -311,6 +538,24 @@ namespace IR {
 
         void process(IR::Node *text) override;
         void push_subpass(IR::Pass *subpass) override;
+
+        /**
+         * Processes block of lines of text through pipeline
+         * Words pass does not depend on other lines, so text can be processed by blocks of lines
+         * @param lines Lines to be processed
+         * @param line_number Number of the first line in the text
+         * @note reset has to be called before the first block of a text
+         */
+        void process(const std::vector<std::list<Word *> *> &lines, size_t line_number);
+
+        /** Resets environment and optimization variables and compiles pipeline before processing a new text */
+        void reset();
+
+        /**
+         * @return True if any expression subpass defers its words
+         * @note Valid after reset
+         */
+        bool has_deferred() const;
     };
 
     /**
@@ -381,11 +626,6 @@ namespace IR {
     };
 }
 
-/**
- * Overloaded operator== for 2 Words used in IR comparison
- */ 
-bool operator==(IR::Word &lhs, IR::Word &rhs);
-
 /**
  * Overloaded operator<< to print easily IR for debugging
  */
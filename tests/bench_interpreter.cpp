@@ -0,0 +1,47 @@
+/**
+ * Benchmarks for interpreter
+ * These measure time, so they are not part of ebetests and are run only by ebebench
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <chrono>
+#include "ir.hpp"
+#include "instruction.hpp"
+#include "text_helpers.hpp"
+
+namespace{
+
+using TestHelpers::numbered_text;
+
+/**
+ * Runs pairwise swap (SWAP 1 in a loop) over new text
+ * @return Time it took in seconds
+ */
+double time_pair_swap(IR::Pass *pass, size_t lines_count, size_t words_count) {
+    auto text = numbered_text(lines_count, words_count);
+    pass->push_back(new Inst::SWAP(1));
+    pass->push_back(new Inst::LOOP());
+    auto start = std::chrono::steady_clock::now();
+    pass->process(text);
+    std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    delete pass;
+    delete text;
+    return took.count();
+}
+
+// Positional instructions have to scale linearly with the number of lines/words
+TEST(InterpreterBench, PositionalInstructionsScaling) {
+    const size_t count = 200000;
+
+    // 8 times smaller input has to take at most 32 times less time (quadratic would be 64)
+    double lines_time = time_pair_swap(new IR::PassLines(), count, 1);
+    double small_lines_time = time_pair_swap(new IR::PassLines(), count / 8, 1);
+    EXPECT_LT(lines_time, 32 * small_lines_time + 0.05);
+
+    double words_time = time_pair_swap(new IR::PassWords(), 1, count);
+    double small_words_time = time_pair_swap(new IR::PassWords(), 1, count / 8);
+    EXPECT_LT(words_time, 32 * small_words_time + 0.05);
+}
+
+}
@@ -0,0 +1,50 @@
+/**
+ * Benchmarks for helper util functions
+ * These measure time, so they are not part of ebetests and are run only by ebebench
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include "utils.hpp"
+
+namespace{
+
+/**
+ * Parses and formats the same numbers as expression passes
+ * @return Time it took in seconds
+ */
+template<typename F>
+double run_conversions(const std::vector<std::string> &numbers, F convert) {
+    auto start = std::chrono::steady_clock::now();
+    size_t length = 0;
+    for(int i = 0; i < 10; ++i) {
+        for(auto &n: numbers) {
+            length += convert(n);
+        }
+    }
+    std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    EXPECT_GT(length, 0);
+    return took.count();
+}
+
+// Number conversions of words have to be faster than strto* and std::to_string
+TEST(CastsBench, ConversionSpeed){
+    std::vector<std::string> numbers;
+    for(int i = 0; i < 100000; ++i) {
+        numbers.push_back(std::to_string(i * 7919 % 20000 - 10000) + "." + std::to_string(i % 100));
+    }
+    auto old_time = run_conversions(numbers, [](const std::string &n) {
+        std::string copy = n;
+        return std::to_string(std::strtof(copy.c_str(), nullptr) * 1.8f + 32.0f).size();
+    });
+    char buffer[Cast::FORMAT_BUFFER_SIZE];
+    auto new_time = run_conversions(numbers, [&buffer](const std::string &n) {
+        return Cast::format(Cast::to<float>(n) * 1.8f + 32.0f, buffer).size();
+    });
+    EXPECT_LT(new_time, old_time);
+}
+
+}
@@ -5,6 +5,8 @@
 #include <gtest/gtest.h>
 #include <string>
 #include <vector>
+#include <thread>
+#include <algorithm>
 #include "arg_parser.hpp"
 
 namespace{
@@ -24,6 +26,7 @@ TEST(ArgumentParsing, Correct){
                                (char *)"--no-warn-print",
                                (char *)"--no-info-print",
                                (char *)"--no-error-print",
+                               (char *)"-j", (char *)"4",
                                (char *)"-expr"};
 
     Args::ArgOpts parser1;
@@ -42,6 +45,7 @@ TEST(ArgumentParsing, Correct){
     EXPECT_EQ(parser1.no_warn_print, true);
     EXPECT_EQ(parser1.no_error_print, true);
     EXPECT_EQ(parser1.no_info_print, true);
+    EXPECT_EQ(parser1.jobs, 4);
 
     // Interpretation all options
     std::vector<char *> args_v2{(char *)"/dev/null", // Input file
@@ -66,6 +70,54 @@ TEST(ArgumentParsing, Correct){
     EXPECT_EQ(parser2.no_warn_print, true);
     EXPECT_EQ(parser2.no_error_print, true);
     EXPECT_EQ(parser2.no_info_print, true);
+
+    // Amount of jobs is capped
+    std::vector<char *> args_v3{(char *)"-i", (char *)"in.ebel", (char *)"/dev/null",
+                                (char *)"--no-warn-print", (char *)"-j", (char *)"1000000"};
+    Args::ArgOpts parser3;
+    parser3.parse(args_v3.size(), &args_v3[0]);
+    EXPECT_LE(parser3.jobs, 4 * std::max(std::thread::hardware_concurrency(), 1u));
+    EXPECT_GE(parser3.jobs, 1);
+}
+
+// Amount of reported expression failures
+TEST(ArgumentParsing, ErrorSamples){
+    // One failure is reported by default
+    std::vector<char *> args_v{(char *)"-i", (char *)"in.ebel", (char *)"/dev/null"};
+    Args::ArgOpts parser1;
+    parser1.parse(args_v.size(), &args_v[0]);
+    EXPECT_EQ(parser1.error_samples, 1);
+
+    std::vector<char *> args_v2{(char *)"-i", (char *)"in.ebel", (char *)"/dev/null",
+                                (char *)"--error-samples", (char *)"25"};
+    Args::ArgOpts parser2;
+    parser2.parse(args_v2.size(), &args_v2[0]);
+    EXPECT_EQ(parser2.error_samples, 25);
+
+    // Only the summary can be reported
+    std::vector<char *> args_v3{(char *)"--error-samples", (char *)"0",
+                                (char *)"-i", (char *)"in.ebel", (char *)"/dev/null"};
+    Args::ArgOpts parser3;
+    parser3.parse(args_v3.size(), &args_v3[0]);
+    EXPECT_EQ(parser3.error_samples, 0);
+
+    // Incorrect, negative, missing and multiple values
+    for(auto value: {"abc", "5x", "-1", ""}) {
+        std::vector<char *> args_inc{(char *)"-i", (char *)"in.ebel", (char *)"/dev/null",
+                                     (char *)"--error-samples", (char *)value};
+        Args::ArgOpts parser_inc;
+        EXPECT_EXIT(parser_inc.parse(args_inc.size(), &args_inc[0]), 
+                    testing::ExitedWithCode(Error::ErrorCode::ARGUMENTS), "") << value;
+    }
+    std::vector<char *> args_v4{(char *)"-i", (char *)"in.ebel", (char *)"/dev/null",
+                                (char *)"--error-samples"};
+    Args::ArgOpts parser4;
+    EXPECT_EXIT(parser4.parse(args_v4.size(), &args_v4[0]), testing::ExitedWithCode(Error::ErrorCode::ARGUMENTS), "");
+
+    std::vector<char *> args_v5{(char *)"-i", (char *)"in.ebel", (char *)"/dev/null",
+                                (char *)"--error-samples", (char *)"2", (char *)"--error-samples", (char *)"3"};
+    Args::ArgOpts parser5;
+    EXPECT_EXIT(parser5.parse(args_v5.size(), &args_v5[0]), testing::ExitedWithCode(Error::ErrorCode::ARGUMENTS), "");
 }
 
 // Correct arguments for ebe
@@ -122,6 +174,15 @@ TEST(ArgumentParsing, Incorrect){
                                 (char *)"-f", (char *)"lev"};
     Args::ArgOpts parser9;
     EXPECT_EXIT(parser9.parse(args_v9.size(), &args_v9[0]), testing::ExitedWithCode(Error::ErrorCode::ARGUMENTS), "");
+
+    // Negative and empty amount of jobs
+    for(auto value: {"-1", ""}) {
+        std::vector<char *> args_v10{(char *)"-i", (char *)"in.ebel", (char *)"/dev/null",
+                                     (char *)"-j", (char *)value};
+        Args::ArgOpts parser10;
+        EXPECT_EXIT(parser10.parse(args_v10.size(), &args_v10[0]), 
+                    testing::ExitedWithCode(Error::ErrorCode::ARGUMENTS), "") << value;
+    }
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,236 @@
+/**
+ * Tests for fitness functions
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include "ir.hpp"
+#include "fitness.hpp"
+
+namespace{
+
+/** Reference word comparison of fitness functions (same text or an expression) */
+bool ref_match(IR::Word *w1, IR::Word *w2) {
+    return w1->get_type() == IR::Type::EXPRESSION || w2->get_type() == IR::Type::EXPRESSION || w1->get_text() == w2->get_text();
+}
+
+/** Reference linearization with new line after each line */
+std::vector<IR::Word *> ref_linearize(IR::Node *ir, IR::Word *nl) {
+    std::vector<IR::Word *> v;
+    for(auto line: *ir->nodes) {
+        v.insert(v.end(), line->begin(), line->end());
+        v.push_back(nl);
+    }
+    return v;
+}
+
+/** Reference Levenshtein similarity using the full distance matrix */
+float ref_levenshtein(IR::Node *ir1, IR::Node *ir2) {
+    IR::Word nl("\n", IR::Type::DELIMITER);
+    auto v1 = ref_linearize(ir1, &nl);
+    auto v2 = ref_linearize(ir2, &nl);
+    if(v1.empty() && v2.empty()) {
+        return 1.0f;
+    }
+    if(v1.empty() || v2.empty()) {
+        return 0.0f;
+    }
+    // Last new line is not part of the distance
+    std::vector<std::vector<long>> dist(v1.size(), std::vector<long>(v2.size()));
+    for(size_t i = 0; i < v1.size(); ++i) {
+        dist[i][0] = i;
+    }
+    for(size_t j = 0; j < v2.size(); ++j) {
+        dist[0][j] = j;
+    }
+    for(size_t i = 1; i < v1.size(); ++i) {
+        for(size_t j = 1; j < v2.size(); ++j) {
+            long cost = ref_match(v1[i-1], v2[j-1]) ? 0 : 1;
+            dist[i][j] = std::min({dist[i-1][j]+1, dist[i][j-1]+1, dist[i-1][j-1]+cost});
+        }
+    }
+    auto max_l = std::max(v1.size(), v2.size());
+    return (max_l-dist[v1.size()-1][v2.size()-1])/static_cast<float>(max_l);
+}
+
+/** Reference Jaro (and Jaro-Winkler when winkler is set) similarity */
+float ref_jaro(IR::Node *ir1, IR::Node *ir2, bool winkler) {
+    IR::Word nl("\n", IR::Type::DELIMITER);
+    auto v1 = ref_linearize(ir1, &nl);
+    auto v2 = ref_linearize(ir2, &nl);
+    long size1 = v1.size();
+    long size2 = v2.size();
+    if(size1 == 0 && size2 == 0) {
+        return 1.0f;
+    }
+    if(size1 == 0 || size2 == 0) {
+        return 0.0f;
+    }
+    long max_dist = std::floor(std::max(size1, size2) / 2) - 1;
+    long matches = 0;
+    std::vector<bool> hash1(size1);
+    std::vector<bool> hash2(size2);
+    for(long i = 0; i < size1; ++i) {
+        for(long j = std::max(0L, i - max_dist); j < std::min(size2, i + max_dist + 1); ++j) {
+            if(!hash2[j] && ref_match(v1[i], v2[j])) {
+                hash1[i] = true;
+                hash2[j] = true;
+                ++matches;
+                break;
+            }
+        }
+    }
+    if(matches == 0) {
+        return 0.0f;
+    }
+    long transp = 0;
+    long index = 0;
+    for(long i = 0; i < size1; ++i) {
+        if(hash1[i]) {
+            while(!hash2[index]) {
+                ++index;
+            }
+            if(!ref_match(v1[i], v2[index])) {
+                ++transp;
+            }
+            ++index;
+        }
+    }
+    float jaro_d = (static_cast<float>(matches) / size1 + static_cast<float>(matches) / size2
+                    + (matches - (transp / 2.0f)) / matches) / 3.0f;
+    if(!winkler || jaro_d < 0.7f || jaro_d >= 1.0f) {
+        return jaro_d;
+    }
+    long prefix = 0;
+    while(prefix < std::min(size1, size2) && ref_match(v1[prefix], v2[prefix])) {
+        ++prefix;
+    }
+    return jaro_d + 0.1 * std::min(4L, prefix) * (1 - jaro_d);
+}
+
+// Levenshtein distance on small texts
+TEST(Fitness, Levenshtein) {
+    auto text1 = new IR::Node();
+    text1->push_back(0, new IR::Word("foo", IR::Type::TEXT));
+    text1->push_back(0, new IR::Word(" ", IR::Type::DELIMITER));
+    text1->push_back(0, new IR::Word("42", IR::Type::NUMBER));
+    text1->push_back(1, new IR::Word("bar", IR::Type::TEXT));
+
+    auto text2 = new IR::Node(*text1);
+    EXPECT_FLOAT_EQ(1.0f, Fitness::levenshtein(text1, text2));
+
+    // One substitution out of 6 tokens (2 new lines included)
+    (*(*text2->nodes->begin())->begin())->set("baz", IR::Type::TEXT);
+    EXPECT_FLOAT_EQ(5.0f/6.0f, Fitness::levenshtein(text1, text2));
+    EXPECT_FLOAT_EQ(5.0f/6.0f, Fitness::levenshtein(text2, text1));
+
+    // Expression matches any word
+    (*(*text2->nodes->begin())->begin())->set("baz", IR::Type::EXPRESSION);
+    EXPECT_FLOAT_EQ(1.0f, Fitness::levenshtein(text1, text2));
+
+    // Deletion of a word
+    text2->push_back(1, new IR::Word("!", IR::Type::SYMBOL));
+    EXPECT_FLOAT_EQ(6.0f/7.0f, Fitness::levenshtein(text1, text2));
+
+    // Substituted delimiter (interned word)
+    auto delim = *std::next((*text2->nodes->begin())->begin());
+    EXPECT_EQ(*delim, IR::Word(" ", IR::Type::DELIMITER));
+    delim->set(",", IR::Type::DELIMITER);
+    EXPECT_NE(*delim, IR::Word(" ", IR::Type::DELIMITER));
+    EXPECT_NE(*delim, IR::Word(",", IR::Type::SYMBOL));
+    EXPECT_TRUE(delim->same_text(IR::Word(",", IR::Type::SYMBOL)));
+    EXPECT_FALSE(delim->same_text(IR::Word(" ", IR::Type::DELIMITER)));
+    EXPECT_TRUE(delim->same_text(IR::Word(",", IR::Type::TEXT)));
+    EXPECT_FLOAT_EQ(5.0f/7.0f, Fitness::levenshtein(text1, text2));
+
+    delete text1;
+    delete text2;
+}
+
+// Words with the same text are the same regardless of their type
+TEST(Fitness, LevenshteinMixedTypes) {
+    auto text1 = new IR::Node();
+    text1->push_back(0, new IR::Word("1", IR::Type::NUMBER));
+    text1->push_back(0, new IR::Word(",", IR::Type::DELIMITER));
+    text1->push_back(0, new IR::Word("2.5", IR::Type::FLOAT));
+    text1->push_back(1, new IR::Word("foo", IR::Type::TEXT));
+
+    auto text2 = new IR::Node();
+    text2->push_back(0, new IR::Word("1", IR::Type::TEXT));
+    text2->push_back(0, new IR::Word(",", IR::Type::SYMBOL));
+    text2->push_back(0, new IR::Word("2.5", IR::Type::TEXT));
+    text2->push_back(1, new IR::Word("foo", IR::Type::SYMBOL));
+
+    EXPECT_FLOAT_EQ(1.0f, Fitness::levenshtein(text1, text2));
+    EXPECT_FLOAT_EQ(1.0f, Fitness::levenshtein(text2, text1));
+    EXPECT_FLOAT_EQ(Fitness::one2one(text1, text2), Fitness::levenshtein(text1, text2));
+
+    // Different text of the same type still does not match
+    (*(*text2->nodes->begin())->begin())->set("2", IR::Type::NUMBER);
+    EXPECT_FLOAT_EQ(5.0f/6.0f, Fitness::levenshtein(text1, text2));
+
+    delete text1;
+    delete text2;
+}
+
+// Scores on texts with words of the same text but different types match the reference
+TEST(Fitness, MixedTypesReference) {
+    const std::vector<std::pair<std::string, IR::Type>> words{
+        {"1", IR::Type::NUMBER}, {"1", IR::Type::TEXT}, {"1.5", IR::Type::FLOAT}, {"1.5", IR::Type::TEXT},
+        {",", IR::Type::DELIMITER}, {",", IR::Type::SYMBOL}, {",", IR::Type::TEXT}, {" ", IR::Type::DELIMITER},
+        {"#", IR::Type::SYMBOL}, {"#", IR::Type::DELIMITER}, {"a", IR::Type::TEXT}, {"a", IR::Type::SYMBOL},
+        {"\n", IR::Type::TEXT}, {"x", IR::Type::EXPRESSION}
+    };
+    std::mt19937 gen(42);
+    auto random_text = [&](size_t lines) {
+        auto text = new IR::Node();
+        for(size_t i = 0; i < lines; ++i) {
+            auto line = new std::list<IR::Word *>();
+            for(size_t j = gen() % 6; j > 0; --j) {
+                auto &w = words[gen() % words.size()];
+                line->push_back(new IR::Word(w.first, w.second));
+            }
+            text->push_back(line);
+        }
+        return text;
+    };
+    for(int i = 0; i < 200; ++i) {
+        auto text1 = random_text(gen() % 5);
+        auto text2 = random_text(gen() % 5);
+        EXPECT_FLOAT_EQ(ref_levenshtein(text1, text2), Fitness::levenshtein(text1, text2));
+        EXPECT_FLOAT_EQ(ref_jaro(text1, text2, false), Fitness::jaro(text1, text2));
+        EXPECT_FLOAT_EQ(ref_jaro(text1, text2, true), Fitness::jaro_winkler(text1, text2));
+        delete text1;
+        delete text2;
+    }
+}
+
+// Levenshtein distance on texts with many words
+TEST(Fitness, LevenshteinLarge) {
+    const size_t lines = 10000;
+    auto text1 = new IR::Node();
+    auto text2 = new IR::Node();
+    for(size_t i = 0; i < lines; ++i) {
+        auto line1 = new std::list<IR::Word *>();
+        auto line2 = new std::list<IR::Word *>();
+        for(size_t j = 0; j < 4; ++j) {
+            line1->push_back(new IR::Word(std::to_string(i*j % 97), IR::Type::NUMBER));
+            // Every 10th line has its 1st word changed
+            auto text = (j == 0 && i % 10 == 0) ? std::string("x") : std::to_string(i*j % 97);
+            line2->push_back(new IR::Word(text, IR::Type::NUMBER));
+        }
+        text1->push_back(line1);
+        text2->push_back(line2);
+    }
+    const float size = lines * 5;
+    EXPECT_FLOAT_EQ((size - lines / 10) / size, Fitness::levenshtein(text1, text2));
+
+    delete text1;
+    delete text2;
+}
+
+}
@@ -4,14 +4,20 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <algorithm>
 #include "scanner.hpp"
 #include "arg_parser.hpp"
 #include "interpreter.hpp"
 #include "ir.hpp"
+#include "document.hpp"
 #include "instruction.hpp"
+#include "expr_kernel.hpp"
+#include "text_helpers.hpp"
 
 namespace{
 
+using TestHelpers::numbered_text;
+
 // TODO: Add more interpreter tests - for lines and documents
 
 // Testing if interpretation is correct
@@ -73,10 +79,10 @@ TEST(Interpreter, SimpleWordPassCode) {
     inter->parse(text);
 
     // Check 1st and 2nd word
-    EXPECT_EQ(" ", (*(*text->nodes->begin())->begin())->text);
-    EXPECT_EQ("bar", (*std::next((*text->nodes->begin())->begin()))->text);
+    EXPECT_EQ(" ", (*(*text->nodes->begin())->begin())->get_text());
+    EXPECT_EQ("bar", (*std::next((*text->nodes->begin())->begin()))->get_text());
     // Check 1st word on 2nd line
-    EXPECT_EQ(",", (*(*std::next(text->nodes->begin()))->begin())->text);
+    EXPECT_EQ(",", (*(*std::next(text->nodes->begin()))->begin())->get_text());
 
     // Del with loop
     pass->push_back(new Inst::LOOP());
@@ -89,6 +95,28 @@ TEST(Interpreter, SimpleWordPassCode) {
     text_2_empty_lines->push_back(1, new IR::Word("", IR::Type::EMPTY));
     EXPECT_EQ(*text_2_empty_lines, *text);
 
+    // Columnar document has to hold the same text
+    IR::Document doc(*text_copy);
+    EXPECT_EQ(2, doc.get_lines_count());
+    EXPECT_EQ(8, doc.get_words_count());
+    EXPECT_EQ("bar", doc.text(2));
+    EXPECT_EQ(IR::Type::FLOAT, doc.type(7));
+    auto doc_node = doc.to_node();
+    EXPECT_EQ(*text_copy, *doc_node);
+    EXPECT_EQ(text_copy->output(), doc_node->output());
+    delete doc_node;
+
+    // Reset interpreted text back to the original
+    text->reset(doc);
+    EXPECT_EQ(*text_copy, *text);
+    EXPECT_EQ(text_copy->get_max_words_count(), text->get_max_words_count());
+    // Reset again after the interpretation
+    inter->parse(text);
+    EXPECT_EQ(*text_2_empty_lines, *text);
+    text->reset(doc);
+    EXPECT_EQ(*text_copy, *text);
+    EXPECT_EQ(text_copy->get_max_words_count(), text->get_max_words_count());
+
     // TODO: Add some more complex ones
 
     delete text_2_empty_lines;
@@ -98,4 +126,192 @@ TEST(Interpreter, SimpleWordPassCode) {
     delete inter;
 }
 
+/**
+ * Runs pairwise swap (SWAP 1 in a loop) over text
+ */
+void run_pair_swap(IR::Pass *pass, IR::Node *text) {
+    pass->push_back(new Inst::SWAP(1));
+    pass->push_back(new Inst::LOOP());
+    pass->process(text);
+}
+
+// Positional instructions on many lines/words (scaling is measured in ebebench)
+TEST(Interpreter, PositionalInstructionsLarge) {
+    const size_t count = 200000;
+
+    // Lines pass over many lines
+    auto text = numbered_text(count, 1);
+    auto lines_pass = new IR::PassLines();
+    run_pair_swap(lines_pass, text);
+    size_t i = 0;
+    for(auto line: *text->nodes) {
+        ASSERT_EQ(std::to_string(i ^ 1), (*line->begin())->get_text());
+        ++i;
+    }
+    EXPECT_EQ(count, i);
+    delete lines_pass;
+    delete text;
+
+    // Words pass over one very long line
+    text = numbered_text(1, count);
+    auto words_pass = new IR::PassWords();
+    run_pair_swap(words_pass, text);
+    i = 0;
+    for(auto word: **text->nodes->begin()) {
+        ASSERT_EQ(std::to_string(i ^ 1), word->get_text());
+        ++i;
+    }
+    EXPECT_EQ(count, i);
+    delete words_pass;
+    delete text;
+}
+
+// Compiled expression passes have to give the same results as generic interpretation
+TEST(Interpreter, CompiledExpression) {
+    auto old_table_size = Args::arg_opts.sym_table_size;
+    Args::arg_opts.sym_table_size = 64;
+    auto make_pass = [](IR::Type type) {
+        auto pass = new IR::PassExpression(type);
+        pass->push_back(new Inst::MOVE(1, new Vars::NumberVar(3)));
+        pass->push_back(new Inst::ADD(2, 1, new Vars::NumberVar(4)));
+        pass->push_back(new Inst::MUL(3, 0, 2));
+        pass->push_back(new Inst::DIV(0, new Vars::NumberVar(1000), 3));
+        return pass;
+    };
+    // Only passes with known input type can be compiled
+    Inst::ExprKernel kernel;
+    auto typed = make_pass(IR::Type::NUMBER);
+    auto derived = make_pass(IR::Type::DERIVED);
+    EXPECT_TRUE(kernel.compile(IR::Type::NUMBER, *typed->pipeline, 64));
+    EXPECT_FALSE(kernel.compile(IR::Type::DERIVED, *derived->pipeline, 64));
+    EXPECT_FALSE(kernel.compile(IR::Type::NUMBER, *typed->pipeline, 2));
+    // Type error fails for every word
+    EXPECT_TRUE(kernel.compile(IR::Type::FLOAT, *typed->pipeline, 64));
+    EXPECT_TRUE(kernel.can_fail());
+    EXPECT_FALSE(kernel.exec());
+
+    for(int i = -20; i <= 20; ++i) {
+        IR::Word compiled(std::to_string(i), IR::Type::NUMBER);
+        IR::Word interpreted(std::to_string(i), IR::Type::NUMBER);
+        // Division by zero is reported and word is not modified
+        typed->process(&compiled, 0, 0);
+        derived->process(&interpreted, 0, 0);
+        EXPECT_EQ(interpreted.get_text(), compiled.get_text());
+        EXPECT_EQ(interpreted.get_type(), compiled.get_type());
+    }
+    delete typed;
+    delete derived;
+
+    // Column evaluation
+    auto columns = new IR::PassExpression(IR::Type::NUMBER);
+    columns->push_back(new Inst::MUL(1, 0, new Vars::NumberVar(9)));
+    columns->push_back(new Inst::DIV(1, 1, new Vars::NumberVar(5)));
+    columns->push_back(new Inst::ADD(0, 1, new Vars::NumberVar(32)));
+    EXPECT_TRUE(columns->is_deferrable());
+    std::vector<IR::Word *> words;
+    for(int i = -3000; i < 3000; ++i) {
+        words.push_back(new IR::Word(std::to_string(i), IR::Type::NUMBER));
+        columns->defer(words.back());
+    }
+    columns->flush();
+    for(int i = -3000; i < 3000; ++i) {
+        EXPECT_EQ(std::to_string(i * 9 / 5 + 32), words[i+3000]->get_text());
+        delete words[i+3000];
+    }
+    delete columns;
+
+    // Constant folding
+    auto folded = new IR::PassExpression(IR::Type::FLOAT);
+    folded->push_back(new Inst::MOVE(1, new Vars::FloatVar(2.0f)));
+    folded->push_back(new Inst::POW(2, 1, new Vars::FloatVar(3.0f)));
+    folded->push_back(new Inst::ADD(0, 0, 2));
+    IR::Word word("0.5", IR::Type::FLOAT);
+    folded->process(&word, 0, 0);
+    EXPECT_EQ("8.5", word.get_text());
+    EXPECT_EQ(IR::Type::FLOAT, word.get_type());
+    delete folded;
+    Args::arg_opts.sym_table_size = old_table_size;
+}
+
+// Failed words are counted and left unmodified
+TEST(Interpreter, ExpressionFailures) {
+    auto old_table_size = Args::arg_opts.sym_table_size;
+    Args::arg_opts.sym_table_size = 64;
+    auto pass = new IR::PassExpression(IR::Type::DERIVED);
+    pass->push_back(new Inst::DIV(0, new Vars::NumberVar(100), 0));
+    std::vector<IR::Word *> words;
+    for(int i = 0; i < 1000; ++i) {
+        // Every 10th word is a text, which fails on type error, division by 0 fails as well
+        if(i % 10 == 0) {
+            words.push_back(new IR::Word("n/a", IR::Type::TEXT));
+        }
+        else {
+            words.push_back(new IR::Word(std::to_string(i % 100 - 51), IR::Type::NUMBER));
+        }
+        pass->process(words.back(), i, 0);
+    }
+    size_t failed = 0;
+    for(int i = 0; i < 1000; ++i) {
+        if(i % 10 == 0) {
+            EXPECT_EQ("n/a", words[i]->get_text());
+            ++failed;
+        }
+        else if(i % 100 == 51) {
+            EXPECT_EQ("0", words[i]->get_text());
+            ++failed;
+        }
+        else {
+            EXPECT_EQ(std::to_string(100 / (i % 100 - 51)), words[i]->get_text());
+        }
+        delete words[i];
+    }
+    EXPECT_EQ(failed, pass->get_failures());
+    // Failures are reset by reporting them
+    auto old_no_error_print = Args::arg_opts.no_error_print;
+    Args::arg_opts.no_error_print = true;
+    pass->report_failures({}, "Expression", "test");
+    Args::arg_opts.no_error_print = old_no_error_print;
+    EXPECT_EQ(0, pass->get_failures());
+    delete pass;
+    Args::arg_opts.sym_table_size = old_table_size;
+}
+
+/**
+ * Counts occurrences of text in a string
+ */
+size_t count_occurrences(const std::string &str, const std::string &text) {
+    size_t count = 0;
+    for(auto pos = str.find(text); pos != std::string::npos; pos = str.find(text, pos + text.size())) {
+        ++count;
+    }
+    return count;
+}
+
+// Only --error-samples failures are printed followed by the count of all of them
+TEST(Interpreter, ExpressionFailureSamples) {
+    auto old_table_size = Args::arg_opts.sym_table_size;
+    Args::arg_opts.sym_table_size = 64;
+    const size_t failing = 50;
+    auto old_samples = Args::arg_opts.error_samples;
+    for(size_t samples: {0, 1, 7, 100}) {
+        Args::arg_opts.error_samples = samples;
+        auto pass = new IR::PassExpression(IR::Type::DERIVED);
+        pass->push_back(new Inst::DIV(0, new Vars::NumberVar(100), 0));
+        for(size_t i = 0; i < failing * 2; ++i) {
+            // Every other word is divided by 0
+            IR::Word word(std::to_string(i % 2), IR::Type::NUMBER);
+            pass->process(&word, i, 0);
+        }
+        testing::internal::CaptureStderr();
+        pass->report_failures({}, "Expression", "test");
+        auto printed = testing::internal::GetCapturedStderr();
+        EXPECT_EQ(std::min(samples, failing), count_occurrences(printed, "won't be modified")) << printed;
+        EXPECT_EQ(1, count_occurrences(printed, "Expression failed on 50 words in test")) << printed;
+        EXPECT_EQ(samples < failing ? 1 : 0, count_occurrences(printed, "use --error-samples")) << printed;
+        delete pass;
+    }
+    Args::arg_opts.error_samples = old_samples;
+    Args::arg_opts.sym_table_size = old_table_size;
+}
+
 }
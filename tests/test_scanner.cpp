@@ -4,10 +4,21 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <functional>
 #include "scanner_text.hpp"
 #include "scanner_ebel.hpp"
+#include "ebel_binary.hpp"
 #include "arg_parser.hpp"
+#include "workers.hpp"
 #include "ir.hpp"
+#include "instruction.hpp"
+#include "symbol_table.hpp"
+#include "compiler.hpp"
+#include "utils.hpp"
 
 namespace{
 
@@ -45,8 +56,8 @@ TEST(Scanner, ScannerText) {
         int j = 0;
         for(auto word: *line){
             ASSERT_EQ(true, (j < in_types[i].size())) << "Somehow scanner created more words then there were";
-            EXPECT_EQ(word->type, in_types[i][j]) << "Parsed and expected types do not match for " << word->text;
-            EXPECT_EQ(word->text, in_values[i][j]) << "Parsed and expected values do not match for " << word->text;
+            EXPECT_EQ(word->get_type(), in_types[i][j]) << "Parsed and expected types do not match for " << word->get_text();
+            EXPECT_EQ(word->get_text(), in_values[i][j]) << "Parsed and expected values do not match for " << word->get_text();
             ++j;
         }
         ++i;
@@ -57,6 +68,106 @@ TEST(Scanner, ScannerText) {
     delete s;
 }
 
+// Hand-written tokenizer has to produce the same words as flex lexer
+TEST(Scanner, TokenizerText) {
+    Args::arg_opts.expr = false;
+
+    std::string corpus = "Hello 42+5.0e+10\n78\n\n3e,66f\t00001\n"
+                         "-5 a-5 --7 -3e -1.5e-3 1.5e 1.5E+ 12.x 12. .5 1.5abc abc12.5 0x1F\n"
+                         "{!}!} {! 1 + 2 !} \"quoted\" $1 (2) 3^4%5*6/7\r\n"
+                         "\xc3\xa9t\xc3\xa9 \xf5\xf4x \x7f\x01 un_der_score Long_word_to_fill_vector_registers_0123456789\n"
+                         "\n\n   \v\f;:,.\n"
+                         "no new line at the end";
+    // Random text from characters with special meaning
+    const std::string alphabet = "09aZe_E-+.,;: \t\n{!}\"\xc3\xa9\xf5";
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> dist(0, alphabet.size()-1);
+    corpus += "\n";
+    for(int i = 0; i < 20000; ++i) {
+        corpus += alphabet[dist(gen)];
+    }
+
+    auto flex = new TextFile::ScannerText();
+    flex->set_tokenizer(false);
+    auto tokenizer = new TextFile::ScannerText();
+    std::istringstream flex_text(corpus);
+    std::istringstream tokenizer_text(corpus);
+    auto flex_ir = flex->process(&flex_text, "tests_file");
+    auto tokenizer_ir = tokenizer->process(&tokenizer_text, "tests_file");
+
+    ASSERT_EQ(flex_ir->nodes->size(), tokenizer_ir->nodes->size());
+    auto tok_line = tokenizer_ir->nodes->begin();
+    for(auto line: *flex_ir->nodes) {
+        ASSERT_EQ(line->size(), (*tok_line)->size());
+        auto tok_word = (*tok_line)->begin();
+        for(auto word: *line) {
+            EXPECT_EQ(word->get_type(), (*tok_word)->get_type()) << "Types do not match for " << word->get_text();
+            EXPECT_EQ(word->get_text(), (*tok_word)->get_text());
+            ++tok_word;
+        }
+        ++tok_line;
+    }
+
+    delete flex_ir;
+    delete tokenizer_ir;
+    delete flex;
+    delete tokenizer;
+}
+
+// Text scanned in chunks by multiple workers has to be the same as when scanned at once
+TEST(Scanner, ParallelScan) {
+    Args::arg_opts.expr = false;
+
+    // Text has to be large enough to be split into multiple chunks
+    std::string corpus;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> words(0, 12);
+    for(int i = 0; i < 40000; ++i) {
+        int count = words(gen);
+        for(int j = 0; j < count; ++j) {
+            corpus += "word-" + std::to_string(gen() % 1000) + (j % 3 == 0 ? ", " : " ") + std::to_string(gen() % 100) + ".5";
+        }
+        corpus += "\n";
+    }
+    corpus += "last line";
+
+    WorkerPool workers(4);
+    auto s = new TextFile::ScannerText();
+    std::istringstream serial_text(corpus);
+    std::istringstream parallel_text(corpus);
+    auto serial_ir = s->process(&serial_text, "tests_file");
+    auto parallel_ir = s->process(&parallel_text, "tests_file", workers);
+
+    EXPECT_EQ(serial_ir->output(), parallel_ir->output());
+    ASSERT_EQ(serial_ir->nodes->size(), parallel_ir->nodes->size());
+    EXPECT_EQ(serial_ir->get_max_words_count(), parallel_ir->get_max_words_count());
+    auto parallel_line = parallel_ir->nodes->begin();
+    for(auto line: *serial_ir->nodes) {
+        if(line == serial_ir->longest_line) {
+            EXPECT_EQ(*parallel_line, parallel_ir->longest_line) << "Longest line is not the first one";
+        }
+        ++parallel_line;
+    }
+
+    // Mapped files are tokenized in place
+    auto path = (std::filesystem::temp_directory_path() / "ebe_test_parallel_scan.txt").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << corpus;
+    }
+    auto mapped = Utils::MappedFileStream::open(path.c_str());
+    ASSERT_NE(nullptr, mapped);
+    auto mapped_ir = s->process(mapped, "tests_file", workers);
+    EXPECT_EQ(serial_ir->output(), mapped_ir->output());
+    delete mapped_ir;
+    delete mapped;
+    std::filesystem::remove(path);
+
+    delete serial_ir;
+    delete parallel_ir;
+    delete s;
+}
+
 TEST(CodeScanner, ScannerEbel) {
     auto s = new EbelFile::ScannerEbel();
 
@@ -114,4 +225,154 @@ TEST(CodeScanner, ScannerEbel) {
     delete s;
 }
 
+// Precompiled ebel has to be loaded as the same program
+TEST(CodeScanner, BinaryEbel) {
+    auto s = new EbelFile::ScannerEbel();
+    std::istringstream code("@pragma sym_table_size 7\n\
+        PASS words\n\
+            NOP\n\
+            PASS number expression\n\
+                ADD $1, $0, 2.5\n\
+                MOVE $2, \"txt\"\n\
+                MUL $0, 3, $1\n\
+            RETURN\n\
+            SWAP 1\n\
+        PASS lines\n\
+            CONCAT 2\n\
+            LOOP\n\
+    ");
+    auto program = s->process(&code, "");
+
+    auto path = (std::filesystem::temp_directory_path() / "ebe_test_binary.ebelc").string();
+    EXPECT_TRUE(EbelFile::is_binary_name(path));
+    {
+        std::ofstream file(path, std::ios::binary);
+        EbelFile::save_binary(program, file);
+    }
+    auto loaded = EbelFile::load_binary(path.c_str());
+    ASSERT_TRUE(loaded != nullptr);
+
+    std::stringstream program_code;
+    std::stringstream loaded_code;
+    program_code << *program;
+    loaded_code << *loaded;
+    EXPECT_EQ(program_code.str(), loaded_code.str());
+    EXPECT_EQ(loaded->pragmas->get_sym_table_size(), 7);
+
+    // Text ebel is not loaded as binary
+    {
+        std::ofstream file(path);
+        file << *program;
+    }
+    EXPECT_TRUE(EbelFile::load_binary(path.c_str()) == nullptr);
+
+    std::filesystem::remove(path);
+    delete loaded;
+    delete program;
+    delete s;
+}
+
+/**
+ * Saves simple program with an expression pass as binary ebel after it is modified
+ * @param path Path to save the program into
+ * @param modify Function modifying the parsed program
+ */
+void save_modified(const std::string &path, const std::function<void(IR::EbelNode *)> &modify) {
+    EbelFile::ScannerEbel s;
+    std::istringstream code("PASS words\n\
+        PASS number expression\n\
+            ADD $1, $0, 1\n\
+        RETURN\n\
+    ");
+    auto program = s.process(&code, "");
+    modify(program);
+    std::ofstream file(path, std::ios::binary);
+    EbelFile::save_binary(program, file);
+    delete program;
+}
+
+/**
+ * Checks that loading binary ebel exits as corrupted
+ * @param path Path to the binary ebel
+ */
+void expect_corrupted(const std::string &path) {
+    EXPECT_EXIT(EbelFile::load_binary(path.c_str()), testing::ExitedWithCode(Error::ErrorCode::SYNTACTIC), "");
+}
+
+// Binary ebel with register index out of symbol table is refused
+TEST(CodeScanner, CorruptedBinaryEbel) {
+    auto path = (std::filesystem::temp_directory_path() / "ebe_test_corrupted.ebelc").string();
+    // Sets symbol table size and appends inst to the expression pass
+    auto with_registers = [](int sym_table_size, Inst::Instruction *inst) {
+        return [=](IR::EbelNode *program) {
+            program->pragmas->set_sym_table_size(sym_table_size);
+            (*program->nodes->front()->subpass_table)[0]->push_back(inst);
+        };
+    };
+
+    save_modified(path, with_registers(7, new Inst::ADD(-50000000, 0, new Vars::NumberVar(1))));
+    expect_corrupted(path);
+    save_modified(path, with_registers(0, new Inst::MOVE(-1, 0)));
+    expect_corrupted(path);
+    save_modified(path, with_registers(7, new Inst::MOVE(0, 7)));
+    expect_corrupted(path);
+    save_modified(path, with_registers(-1, new Inst::MOVE(0, 1)));
+    expect_corrupted(path);
+
+    // Registers in range are loaded
+    save_modified(path, with_registers(7, new Inst::MOVE(0, 6)));
+    auto loaded = EbelFile::load_binary(path.c_str());
+    EXPECT_TRUE(loaded != nullptr);
+    delete loaded;
+    std::filesystem::remove(path);
+}
+
+// Binary ebel with instructions its passes cannot interpret is refused
+TEST(CodeScanner, MalformedBinaryEbel) {
+    auto path = (std::filesystem::temp_directory_path() / "ebe_test_malformed.ebelc").string();
+    // CALL without a return instruction
+    save_modified(path, [](IR::EbelNode *program) {
+        auto pipeline = program->nodes->front()->pipeline;
+        delete pipeline->back();
+        pipeline->pop_back();
+    });
+    expect_corrupted(path);
+
+    // CALL of a words pass
+    save_modified(path, [](IR::EbelNode *program) {
+        auto &subpass = (*program->nodes->front()->subpass_table)[0];
+        delete subpass;
+        subpass = new IR::PassWords();
+    });
+    expect_corrupted(path);
+
+    // Non-expression instruction in an expression pass
+    save_modified(path, [](IR::EbelNode *program) {
+        (*program->nodes->front()->subpass_table)[0]->push_back(new Inst::SWAP(1));
+    });
+    expect_corrupted(path);
+
+    // Expression instruction in a words pass
+    save_modified(path, [](IR::EbelNode *program) {
+        program->nodes->front()->push_back(new Inst::MOVE(0, 0));
+    });
+    expect_corrupted(path);
+
+    // CALL in a lines pass
+    save_modified(path, [](IR::EbelNode *program) {
+        auto lines = new IR::PassLines();
+        lines->push_back(new Inst::CALL(0));
+        lines->push_back(new Inst::NOP());
+        program->push_back(lines);
+    });
+    expect_corrupted(path);
+
+    // Unmodified program is loaded
+    save_modified(path, [](IR::EbelNode *) {});
+    auto loaded = EbelFile::load_binary(path.c_str());
+    EXPECT_TRUE(loaded != nullptr);
+    delete loaded;
+    std::filesystem::remove(path);
+}
+
 }
@@ -4,8 +4,17 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <cstdlib>
+#include <climits>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#include <thread>
 #include "utils.hpp"
+#include "pool.hpp"
 #include "exceptions.hpp"
+#include "compiler.hpp"
+#include "workers.hpp"
 
 namespace{
 
@@ -69,4 +78,87 @@ TEST(Casts, To){
     }
 }
 
+// Formatted numbers have to be parsed back into the same value
+TEST(Casts, Format){
+    char buffer[Cast::FORMAT_BUFFER_SIZE];
+    for(int value: {0, 1, -1, 42, INT_MAX, INT_MIN}) {
+        EXPECT_EQ(std::to_string(value), Cast::format(value, buffer));
+        EXPECT_EQ(value, Cast::to<int>(std::string(Cast::format(value, buffer))));
+    }
+
+    EXPECT_EQ("8.0", Cast::format(8.0f, buffer));
+    EXPECT_EQ("-0.5", Cast::format(-0.5f, buffer));
+    EXPECT_EQ("0.1", Cast::format(0.1f, buffer));
+    EXPECT_EQ("inf", Cast::format(1.0f/0.0f, buffer));
+    for(float value: {3.14159f, -1e-7f, 1.17549435e-38f, 1.4e-45f, 3.40282347e+38f, -3.40282347e+38f}) {
+        EXPECT_EQ(value, Cast::to<float>(std::string(Cast::format(value, buffer))));
+    }
+    // Values strtof accepts, but from_chars does not have to be parsed as well
+    EXPECT_EQ(8.0f, Cast::to<float>("0x1p3"));
+    EXPECT_EQ(42, Cast::to<int>(" +42"));
+}
+
+// Conversions of words have to give the same values as strto* (as in expression passes)
+TEST(Casts, ConversionRoundTrip){
+    char buffer[Cast::FORMAT_BUFFER_SIZE];
+    for(int i = 0; i < 100000; ++i) {
+        auto n = std::to_string(i * 7919 % 20000 - 10000) + "." + std::to_string(i % 100);
+        float value = Cast::to<float>(n);
+        ASSERT_EQ(std::strtof(n.c_str(), nullptr), value) << n;
+        value = value * 1.8f + 32.0f;
+        ASSERT_EQ(value, Cast::to<float>(std::string(Cast::format(value, buffer)))) << n;
+        int number = i * 7919 % 20000 - 10000;
+        ASSERT_EQ(number, Cast::to<int>(std::string(Cast::format(number, buffer))));
+    }
+}
+
+// Fatal error in a worker task (such as unwritable output with -j) has to exit cleanly
+TEST(WorkerPool, FatalErrorInTask){
+    // Pool threads are created in the death test process only
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    auto out_dir = std::filesystem::temp_directory_path() / "ebe_test_worker_error";
+    std::filesystem::create_directories(out_dir / "edited-f5.txt");
+    EXPECT_EXIT({
+        Args::arg_opts.jobs = 4;
+        Args::arg_opts.no_error_print = true;
+        WorkerPool::get().run(6, [&](size_t, size_t i) {
+            auto file_name = (out_dir / ("edited-f" + std::to_string(i) + ".txt")).string();
+            int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+            if(fd < 0) {
+                Error::error(Error::ErrorCode::FILE_ACCESS, ("Could not open output file "+file_name).c_str());
+            }
+            close(fd);
+        });
+    }, ::testing::ExitedWithCode(Error::ErrorCode::FILE_ACCESS), "");
+    std::filesystem::remove_all(out_dir);
+}
+
+using TestPool = Utils::FixedPool<8, 16>;
+/** Pool for every thread of the test */
+thread_local TestPool pool;
+
+// Pool blocks are released only once no slot of any thread's pool is used
+TEST(FixedPool, ReleaseAll){
+    std::vector<void *> slots;
+    // Allocated by other thread and released by this one
+    std::thread worker([&]() {
+        for(int i = 0; i < 40; ++i) {
+            slots.push_back(pool.allocate());
+        }
+    });
+    worker.join();
+    for(int i = 0; i < 39; ++i) {
+        pool.release(slots[i]);
+    }
+    EXPECT_FALSE(TestPool::release_all());
+    pool.release(slots[39]);
+    EXPECT_TRUE(TestPool::release_all());
+    // Pool can be used after release
+    void *slot = pool.allocate();
+    EXPECT_NE(nullptr, slot);
+    EXPECT_FALSE(TestPool::release_all());
+    pool.release(slot);
+    EXPECT_TRUE(TestPool::release_all());
+}
+
 }
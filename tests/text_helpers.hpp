@@ -0,0 +1,33 @@
+/**
+ * Helpers creating texts for interpreter tests and benchmarks
+ */
+
+#ifndef _TEXT_HELPERS_HPP_
+#define _TEXT_HELPERS_HPP_
+
+#include <string>
+#include <list>
+#include "ir.hpp"
+
+namespace TestHelpers {
+
+/**
+ * Creates text of lines_count lines with words_count words each
+ * First word of a line holds the line number, other words hold their position in the line
+ */
+inline IR::Node *numbered_text(size_t lines_count, size_t words_count) {
+    auto text = new IR::Node();
+    for(size_t i = 0; i < lines_count; ++i) {
+        auto line = new std::list<IR::Word *>();
+        line->push_back(new IR::Word(std::to_string(i), IR::Type::NUMBER));
+        for(size_t j = 1; j < words_count; ++j) {
+            line->push_back(new IR::Word(std::to_string(j), IR::Type::NUMBER));
+        }
+        text->push_back(line);
+    }
+    return text;
+}
+
+}
+
+#endif//_TEXT_HELPERS_HPP_
@@ -18,6 +18,7 @@
 #include <string>
 #include <filesystem>
 #include <chrono>
+#include <thread>
 #include "arg_parser.hpp"
 #include "ebe.hpp"
 #include "compiler.hpp"
@@ -36,6 +37,8 @@ const char *HELP_TEXT =
 "  -in --example-input <file>   File from which will be read input example text.\n"
 "  -out --example-output <file> File from which will be read output example text.\n"
 "  -eo --ebel-output <file>     File to which will be output program saved.\n"
+"                               Files with .ebelc extension are saved precompiled\n"
+"                               (binary), which can be used with -i as well.\n"
 "  -i --interpret <file>        Ebel code to be interpreted over all other argument files.\n"
 "  -o --interpret-output <file> File or folder where will be transfomed file(s) saved.\n"
 "  -expr --expressions          Expressions between \"{!\" and \"!}\" will be generated\n"
@@ -46,6 +49,9 @@ const char *HELP_TEXT =
 "  -f --fitness <name>          Fitness function to be used for compilation\n"
 "  -p --precision <1-100>       Minimal compilation precision, if omitted then 100.\n"
 "  -t --timeout <s>             Compilation timeout (in seconds).\n"
+"  -j --jobs <amount>           Number of worker threads to be used (at most 4 per core).\n"
+"  --error-samples <amount>     Number of words failed in an expression, which are\n"
+"                               reported for each expression (others are only counted).\n"
 "  --version                    Prints compiler's version.\n"
 "  --help -h                    Prints this text.\n"
 "\n"
@@ -98,6 +104,8 @@ namespace Args {
             << TAB1"no_warn_print = " << param.no_warn_print << std::endl
             << TAB1"no_error_print = " << param.no_error_print << std::endl
             << TAB1"no_info_print = " << param.no_info_print << std::endl
+            << TAB1"jobs = " << param.jobs << std::endl
+            << TAB1"error_samples = " << param.error_samples << std::endl
             ;
         return out;
     }
@@ -119,10 +127,25 @@ namespace Args {
     std::exit(0);
 }
 
+/**
+ * Converts option value to unsigned int
+ * strtoul would wrap negative values around and accept empty value as 0, so these are refused
+ * @param value Option value
+ * @return Converted value
+ * @throw Exception::EbeTypeException when the value is not an unsigned number
+ */
+static unsigned int to_unsigned(const char *value) {
+    if(value[0] == '-' || value[0] == '\0') {
+        throw Exception::EbeTypeException(std::string("Could not convert value \"")+value+"\" to unsigned int");
+    }
+    return Cast::to<unsigned int>(value);
+}
+
 void Args::ArgOpts::parse(int argc, char *argv[]) {
     bool changed_analytics = false;
     bool changed_aout = false;
     bool changed_v = false;
+    bool changed_error_samples = false;
 
     if(argc == 0){
         print_help();
@@ -382,6 +405,9 @@ void Args::ArgOpts::parse(int argc, char *argv[]) {
                     Error::error(Error::ErrorCode::ARGUMENTS,
                                  "Multiple -v values were specified");
                 }
+#ifdef DISABLE_LOGGING
+                Error::warning("Ebe was compiled without logging, -v option has no effect");
+#endif
                 if(arg.size() == 2) {
                     // -v
                     this->logging_level = 1;
@@ -485,6 +511,51 @@ void Args::ArgOpts::parse(int argc, char *argv[]) {
                                 "Missing value for --population-size option");
                 }
             }
+            else if(arg == "-j" || arg == "--jobs") {
+                if(this->jobs > 0) {
+                    Error::error(Error::ErrorCode::ARGUMENTS,
+                                 "Multiple --jobs (-j) values were specified");
+                }
+                if(argc > i+1) {
+                    try{
+                        this->jobs = to_unsigned(argv[++i]);
+                        if(this->jobs == 0) {
+                            Error::error(Error::ErrorCode::ARGUMENTS, 
+                               "Incorrect value for --jobs (-j). Value has to be bigger than 0");
+                        }
+                        // More threads than this only compete for the same cores
+                        const size_t max_jobs = 4 * std::max(std::thread::hardware_concurrency(), 1u);
+                        if(this->jobs > max_jobs) {
+                            Error::warning(("Value for --jobs (-j) is too big, using "+std::to_string(max_jobs)).c_str());
+                            this->jobs = max_jobs;
+                        }
+                    } catch (Exception::EbeException e){
+                        Error::error(Error::ErrorCode::ARGUMENTS, "Incorrect value for --jobs (-j)", &e);
+                    }
+                }
+                else {
+                    Error::error(Error::ErrorCode::ARGUMENTS, 
+                                "Missing value for --jobs (-j) option");
+                }
+            }
+            else if(arg == "--error-samples") {
+                if(changed_error_samples) {
+                    Error::error(Error::ErrorCode::ARGUMENTS,
+                                 "Multiple --error-samples values were specified");
+                }
+                if(argc > i+1) {
+                    try{
+                        this->error_samples = to_unsigned(argv[++i]);
+                    } catch (Exception::EbeException e){
+                        Error::error(Error::ErrorCode::ARGUMENTS, "Incorrect value for --error-samples", &e);
+                    }
+                }
+                else {
+                    Error::error(Error::ErrorCode::ARGUMENTS, 
+                                "Missing value for --error-samples option");
+                }
+                changed_error_samples = true;
+            }
             else if(arg == "--version") {
                 if(argc > 1) {
                     Error::error(Error::ErrorCode::ARGUMENTS, 
@@ -604,11 +675,12 @@ void Args::ArgOpts::parse(int argc, char *argv[]) {
             Error::error(Error::ErrorCode::ARGUMENTS, 
                      "Missing output example file (-out)");
         }
-        if(this->ebel_out != nullptr) {
-            auto parent_path = std::filesystem::path(this->ebel_out).parent_path();
-            if(!parent_path.empty() && !std::filesystem::exists(parent_path)){
-                Error::error(Error::ErrorCode::FILE_ACCESS, "Ebel output parent folder does not exit");
-            }
+    }
+    if(this->ebel_out != nullptr) {
+        // In interpretation mode interpreted ebel is saved (e.g. precompiled)
+        auto parent_path = std::filesystem::path(this->ebel_out).parent_path();
+        if(!parent_path.empty() && !std::filesystem::exists(parent_path)){
+            Error::error(Error::ErrorCode::FILE_ACCESS, "Ebel output parent folder does not exit");
         }
     }
     if(this->interpret_mode || this->execute_mode){
@@ -669,6 +741,9 @@ void Args::ArgOpts::parse(int argc, char *argv[]) {
     if(this->sym_table_size == 0) {
         this->sym_table_size = 64;
     }
+    if(this->jobs == 0) {
+        this->jobs = 1;
+    }
 }
 
 void Args::ArgOpts::start_timer() {
@@ -56,6 +56,8 @@ namespace Args {
         bool no_error_print;   ///< If non critical errors should be surpressed
         bool no_info_print;    ///< If info messages should be surpressed
         size_t population_size;///< Population size for engine params
+        size_t jobs;           ///< Amount of worker threads to be used
+        size_t error_samples;  ///< Amount of failed words reported for each expression pass
 
         /** Time when Ebe was started */
         std::chrono::time_point<std::chrono::steady_clock> start_time;
@@ -92,7 +94,9 @@ namespace Args {
                     no_warn_print{false},
                     no_error_print{false},
                     no_info_print{false},
-                    population_size{0} {
+                    population_size{0},
+                    jobs{0},
+                    error_samples{1} {
         }
 
         /**
@@ -0,0 +1,127 @@
+/**
+ * @file binary.hpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Binary serialization
+ *
+ * Writer and reader of binary data used for precompiled ebel files.
+ */
+
+#ifndef _BINARY_HPP_
+#define _BINARY_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "compiler.hpp"
+
+namespace Utils {
+
+    /**
+     * Writer of binary data
+     * Numbers are written in little endian no matter the platform,
+     * strings are prefixed with their length.
+     */
+    class BinaryWriter {
+    private:
+        std::string data;  ///< Written data
+    public:
+        /** @return Written data */
+        const std::string &get_data() const { return data; }
+
+        void write_u8(uint8_t value) {
+            data.push_back(static_cast<char>(value));
+        }
+
+        void write_u32(uint32_t value) {
+            for(int i = 0; i < 4; ++i) {
+                data.push_back(static_cast<char>((value >> (i*8)) & 0xff));
+            }
+        }
+
+        void write_i32(int32_t value) {
+            write_u32(static_cast<uint32_t>(value));
+        }
+
+        void write_float(float value) {
+            uint32_t bits;
+            static_assert(sizeof(bits) == sizeof(value), "Float has to be 32 bits");
+            std::memcpy(&bits, &value, sizeof(bits));
+            write_u32(bits);
+        }
+
+        void write_string(std::string_view value) {
+            write_u32(static_cast<uint32_t>(value.size()));
+            data.append(value);
+        }
+    };
+
+    /**
+     * Reader of data written by BinaryWriter
+     * Reading past the end of the data is reported as an error of corrupted file
+     */
+    class BinaryReader {
+    private:
+        const char *data;  ///< Current position
+        const char *end;   ///< End of the data
+
+        /**
+         * Reports error when less than size bytes are left
+         * @param size Amount of bytes to be read
+         */
+        void require(size_t size) {
+            if(static_cast<size_t>(end - data) < size) {
+                Error::error(Error::ErrorCode::SYNTACTIC, "Binary file is corrupted (unexpected end of file)");
+            }
+        }
+    public:
+        /**
+         * Constructor
+         * @param data Data to read
+         * @param size Size of the data
+         */
+        BinaryReader(const char *data, size_t size) : data{data}, end{data + size} {}
+
+        /** @return True if the whole data was read */
+        bool at_end() const { return data == end; }
+
+        uint8_t read_u8() {
+            require(1);
+            return static_cast<uint8_t>(*data++);
+        }
+
+        uint32_t read_u32() {
+            require(4);
+            uint32_t value = 0;
+            for(int i = 0; i < 4; ++i) {
+                value |= static_cast<uint32_t>(static_cast<uint8_t>(*data++)) << (i*8);
+            }
+            return value;
+        }
+
+        int32_t read_i32() {
+            return static_cast<int32_t>(read_u32());
+        }
+
+        float read_float() {
+            uint32_t bits = read_u32();
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        std::string read_string() {
+            uint32_t size = read_u32();
+            require(size);
+            std::string value(data, size);
+            data += size;
+            return value;
+        }
+    };
+
+}
+
+#endif//_BINARY_HPP_
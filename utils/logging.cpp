@@ -61,6 +61,13 @@ void Logger::debug(unsigned level, const std::string &file_func, const std::stri
     }
 }
 
+bool Logger::is_unit_enabled(const char *file, const char *func) const {
+    if (log_everything) {
+        return true;
+    }
+    return enabled.find(std::string(file)+std::string("::")+std::string(func)) != enabled.end();
+}
+
 Analytics::Analytics() : BaseLogger() {
 
 }
@@ -78,6 +78,13 @@ public:
 
     /** Getter for log_everything */
     bool is_log_everything() { return this->log_everything; }
+
+    /**
+     * Checks if messages of certain level would be logged
+     * This is cheap, so it should be checked before any message formatting
+     * @param level Verbosity level
+     */
+    bool is_logged(unsigned level) const { return !this->disable && level <= this->logging_level; }
 };
 
 
@@ -105,6 +112,14 @@ public:
      */
     void debug(unsigned level, const std::string &file_func, const std::string &message);
 
+    /**
+     * Checks if file::function has logging enabled
+     * @param file File name
+     * @param func Function name
+     * @return true if messages from this function should be logged
+     */
+    bool is_unit_enabled(const char *file, const char *func) const;
+
     
     /**
      * Set file::functions to output to log
@@ -191,27 +206,26 @@ public:
 
 /// Logging macro
 #ifndef DISABLE_LOGGING
+    /// Formats and logs message only when its level and unit are enabled
     /// @param level Verbosity level
-    /// @param message Can be even stream
-    #define LOG(level, message) if ((level) <= MAX_LOGGING_LEVEL) { \
+    /// @param format Statements formatting the message into stream out
+    #define LOG_FORMATTED(level, format) if ((level) <= MAX_LOGGING_LEVEL && Logger::get().is_logged(level) \
+            && Logger::get().is_unit_enabled(__FILENAME__, __func__)) { \
         std::stringstream out; \
         out.setf(Logger::get().get_flags()); \
-        out << message; \
+        format \
         Logger::get().debug(level, std::string(__FILENAME__)+std::string("::")+std::string(__func__), out.str()); }
+    /// @param level Verbosity level
+    /// @param message Can be even stream
+    #define LOG(level, message) LOG_FORMATTED(level, out << message;)
     /// Logs whole container
-    #define LOG_CONT(level, message, container) if ((level) <= MAX_LOGGING_LEVEL) { \
-        std::stringstream out; \
-        out.setf(Logger::get().get_flags()); \
+    #define LOG_CONT(level, message, container) LOG_FORMATTED(level, \
         out << message << std::endl; \
-        for(auto v: (container)) { out << TAB1 << v << std::endl; } \
-        Logger::get().debug(level, std::string(__FILENAME__)+std::string("::")+std::string(__func__), out.str()); }
+        for(auto v: (container)) { out << TAB1 << v << std::endl; })
     /// Logs container of strings which will be sanitized (removes escape sequences)
-    #define LOG_CONT_SANITIZE(level, message, container) if ((level) <= MAX_LOGGING_LEVEL) { \
-        std::stringstream out; \
-        out.setf(Logger::get().get_flags()); \
+    #define LOG_CONT_SANITIZE(level, message, container) LOG_FORMATTED(level, \
         out << message << std::endl; \
-        for(auto v: (container)) { out << Utils::sanitize(v) << std::endl; } \
-        Logger::get().debug(level, std::string(__FILENAME__)+std::string("::")+std::string(__func__), out.str()); }
+        for(auto v: (container)) { out << Utils::sanitize(v) << std::endl; })
 #else
     #define LOG(level, message)
     #define LOG_CONT(level, message, container)
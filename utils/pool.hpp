@@ -0,0 +1,158 @@
+/**
+ * @file pool.hpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Memory pool
+ *
+ * Pool of fixed size memory slots for objects which are allocated
+ * and freed in large numbers (words of a text).
+ */
+
+#ifndef _POOL_HPP_
+#define _POOL_HPP_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+namespace Utils {
+
+    /**
+     * Pool of fixed size memory slots
+     * Memory is taken in large blocks and released slots are kept in a free list
+     * for the following allocations, so allocating and freeing an object is just a pointer swap.
+     * Objects can outlive the pool's thread (e.g. words allocated by a worker and freed by the main thread)
+     * and free lists can hold slots of other pools' blocks, so blocks are returned to the system
+     * only all at once by release_all, when no object of any pool of this type is alive.
+     * @note Pool is not synchronized, every thread has to use its own (thread_local) pool.
+     *       Slot released in other thread than it was allocated in is simply reused by that thread.
+     * @tparam SLOT_SIZE Size of one slot in bytes
+     * @tparam BLOCK_SLOTS Number of slots allocated at once
+     */
+    template<size_t SLOT_SIZE, size_t BLOCK_SLOTS=4096>
+    class FixedPool {
+    private:
+        /** Memory slot, when not used it holds link to the next free one */
+        union Slot {
+            Slot *next;
+            alignas(alignof(std::max_align_t)) char storage[SLOT_SIZE];
+        };
+
+        /** All pools of this type, so that their blocks can be released together */
+        struct Registry {
+            std::mutex lock;
+            std::vector<FixedPool *> pools;
+            std::vector<Slot *> orphan_blocks;  ///< Blocks of pools whose threads ended
+            long orphan_live = 0;               ///< Live objects counted by those pools
+        };
+
+        Slot *free_list;     ///< Released slots
+        Slot *block_next;    ///< First never used slot in the last block
+        Slot *block_end;     ///< End of the last block
+        std::vector<Slot *> blocks;  ///< All allocated blocks
+        long live;           ///< Allocations minus releases done by this pool (can be negative)
+
+        /**
+         * Registry getter
+         * Registry is never destroyed, since thread_local pools of worker threads
+         * can be destroyed after static objects
+         */
+        static Registry &registry() {
+            static Registry *instance = new Registry();
+            return *instance;
+        }
+    public:
+        /** Constructor */
+        FixedPool() : free_list{nullptr}, block_next{nullptr}, block_end{nullptr}, live{0} {
+            auto &reg = registry();
+            std::lock_guard<std::mutex> guard(reg.lock);
+            reg.pools.push_back(this);
+        }
+
+        /**
+         * Destructor
+         * Objects from the blocks can still be alive, so blocks are kept until release_all
+         */
+        ~FixedPool() {
+            auto &reg = registry();
+            std::lock_guard<std::mutex> guard(reg.lock);
+            reg.pools.erase(std::find(reg.pools.begin(), reg.pools.end(), this));
+            reg.orphan_blocks.insert(reg.orphan_blocks.end(), blocks.begin(), blocks.end());
+            reg.orphan_live += live;
+        }
+
+        FixedPool(const FixedPool &other) = delete;
+        FixedPool &operator=(const FixedPool &other) = delete;
+
+        /**
+         * Allocates one slot
+         * @return Memory of SLOT_SIZE bytes
+         */
+        void *allocate() {
+            ++live;
+            if(free_list != nullptr) {
+                Slot *slot = free_list;
+                free_list = slot->next;
+                return slot;
+            }
+            if(block_next == block_end) {
+                block_next = static_cast<Slot *>(::operator new(sizeof(Slot) * BLOCK_SLOTS));
+                blocks.push_back(block_next);
+                block_end = block_next + BLOCK_SLOTS;
+            }
+            return block_next++;
+        }
+
+        /**
+         * Returns slot to the pool
+         * @param ptr Memory returned by allocate (of any pool of the same type)
+         */
+        void release(void *ptr) {
+            Slot *slot = static_cast<Slot *>(ptr);
+            slot->next = free_list;
+            free_list = slot;
+            --live;
+        }
+
+        /**
+         * Returns blocks of all pools of this type to the system
+         * Nothing is released if any object allocated from any of the pools is still alive.
+         * @note No other thread can use any of the pools during the call (e.g. call it between worker pool batches).
+         * @return true if the blocks were released
+         */
+        static bool release_all() {
+            auto &reg = registry();
+            std::lock_guard<std::mutex> guard(reg.lock);
+            long total = reg.orphan_live;
+            for(auto pool: reg.pools) {
+                total += pool->live;
+            }
+            if(total != 0) {
+                return false;
+            }
+            for(auto pool: reg.pools) {
+                for(auto block: pool->blocks) {
+                    ::operator delete(block);
+                }
+                pool->blocks.clear();
+                pool->free_list = nullptr;
+                pool->block_next = nullptr;
+                pool->block_end = nullptr;
+                pool->live = 0;
+            }
+            for(auto block: reg.orphan_blocks) {
+                ::operator delete(block);
+            }
+            reg.orphan_blocks.clear();
+            reg.orphan_live = 0;
+            return true;
+        }
+    };
+
+}
+
+#endif//_POOL_HPP_
@@ -13,6 +13,15 @@
 #include <sstream>
 #include <regex>
 #include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <cerrno>
+#include <cstring>
+#include <charconv>
+#include <cmath>
 #include "utils.hpp"
 #include "exceptions.hpp"
 #include "compiler.hpp"
@@ -20,6 +29,115 @@
 using namespace Utils;
 using namespace Cast;
 
+MappedFileStream::MappedFileStream(char *data, size_t size) : std::istream(nullptr), data{data}, size{size}, 
+                                                               buffer(data, size) {
+    this->rdbuf(&buffer);
+}
+
+MappedFileStream::~MappedFileStream() {
+    munmap(this->data, this->size);
+}
+
+MappedFileStream *MappedFileStream::open(const char *file_name) {
+    int fd = ::open(file_name, O_RDONLY);
+    if(fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // Mapping stays valid after the file is closed
+    close(fd);
+    if(data == MAP_FAILED) {
+        return nullptr;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+    return new MappedFileStream(static_cast<char *>(data), size);
+}
+
+FdOutputBuffer::FdOutputBuffer(int fd, bool owns_fd) : fd{fd}, owns_fd{owns_fd}, buffer(BUFFER_SIZE) {
+    this->line_buffered = isatty(fd);
+    this->setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+FdOutputBuffer::~FdOutputBuffer() {
+    this->sync();
+    if(this->owns_fd) {
+        close(this->fd);
+    }
+}
+
+bool FdOutputBuffer::write_out(const char *data, size_t size) {
+    struct iovec parts[2] = {
+        {this->pbase(), static_cast<size_t>(this->pptr() - this->pbase())},
+        {const_cast<char *>(data), size}
+    };
+    int first = 0;
+    while(first < 2) {
+        if(parts[first].iov_len == 0) {
+            ++first;
+            continue;
+        }
+        ssize_t written = writev(this->fd, &parts[first], 2 - first);
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        // Skip what was written (writes can be partial)
+        for(size_t left = static_cast<size_t>(written); left > 0 && first < 2;) {
+            size_t skip = std::min(left, parts[first].iov_len);
+            parts[first].iov_base = static_cast<char *>(parts[first].iov_base) + skip;
+            parts[first].iov_len -= skip;
+            left -= skip;
+            if(parts[first].iov_len == 0) {
+                ++first;
+            }
+        }
+    }
+    this->setp(buffer.data(), buffer.data() + buffer.size());
+    return true;
+}
+
+FdOutputBuffer::int_type FdOutputBuffer::overflow(int_type ch) {
+    if(!write_out(nullptr, 0)) {
+        return traits_type::eof();
+    }
+    if(!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *this->pptr() = traits_type::to_char_type(ch);
+        this->pbump(1);
+        if(line_buffered && ch == '\n') {
+            return write_out(nullptr, 0) ? ch : traits_type::eof();
+        }
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize FdOutputBuffer::xsputn(const char *s, std::streamsize n) {
+    size_t size = static_cast<size_t>(n);
+    if(size <= static_cast<size_t>(this->epptr() - this->pptr())) {
+        std::memcpy(this->pptr(), s, size);
+        this->pbump(static_cast<int>(size));
+    }
+    else if(!write_out(s, size)) {
+        // Data that does not fit are written together with the buffer
+        return 0;
+    }
+    if(line_buffered && std::memchr(s, '\n', size) != nullptr && !write_out(nullptr, 0)) {
+        return 0;
+    }
+    return n;
+}
+
+int FdOutputBuffer::sync() {
+    return write_out(nullptr, 0) ? 0 : -1;
+}
+
 std::string Utils::to_upper(std::string text){
     std::string outs(text.length(), '\0');
     std::transform(text.begin(), text.end(), outs.begin(), ::toupper);
@@ -91,11 +209,11 @@ std::string Utils::sanitize(const std::string &text) {
 }
 
 template<typename T>
-T Cast::to(std::string v){
+T Cast::to(const std::string &v){
     Error::error(Error::ErrorCode::INTERNAL, "Unknown argument type conversion");
 }
 
-template<> unsigned int Cast::to(std::string v){
+template<> unsigned int Cast::to(const std::string &v){
     try{
         char *pos = 0;
         auto c = std::strtoul(v.c_str(), &pos, 10);
@@ -108,7 +226,15 @@ template<> unsigned int Cast::to(std::string v){
     }
 }
 
-template<> int Cast::to(std::string v){
+template<> int Cast::to(const std::string &v){
+    // Plain numbers are parsed without locale and errno handling,
+    // strtol is used only for the rest (leading spaces, plus sign, overflow)
+    int value;
+    auto end = v.data() + v.size();
+    auto res = std::from_chars(v.data(), end, value);
+    if(res.ec == std::errc() && res.ptr == end) {
+        return value;
+    }
     try{
         char *pos = 0;
         auto c = std::strtol(v.c_str(), &pos, 10);
@@ -121,7 +247,14 @@ template<> int Cast::to(std::string v){
     }
 }
 
-template<> float Cast::to(std::string v){
+template<> float Cast::to(const std::string &v){
+    // Same as for int, strtof is used only for what from_chars does not parse (hexadecimal, overflow, ...)
+    float value;
+    auto end = v.data() + v.size();
+    auto res = std::from_chars(v.data(), end, value);
+    if(res.ec == std::errc() && res.ptr == end) {
+        return value;
+    }
     try{
         char *pos = 0;
         auto c = std::strtof(v.c_str(), &pos);
@@ -133,3 +266,19 @@ template<> float Cast::to(std::string v){
         throw Exception::EbeTypeException(std::string("Could not convert value \""+v+"\" to float"));
     }
 }
+
+std::string_view Cast::format(int value, char *buffer) {
+    auto res = std::to_chars(buffer, buffer + FORMAT_BUFFER_SIZE, value);
+    return std::string_view(buffer, res.ptr - buffer);
+}
+
+std::string_view Cast::format(float value, char *buffer) {
+    auto res = std::to_chars(buffer, buffer + FORMAT_BUFFER_SIZE, value, std::chars_format::fixed);
+    std::string_view text(buffer, res.ptr - buffer);
+    if(std::isfinite(value) && text.find('.') == std::string_view::npos) {
+        *res.ptr++ = '.';
+        *res.ptr++ = '0';
+        text = std::string_view(buffer, res.ptr - buffer);
+    }
+    return text;
+}
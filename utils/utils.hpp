@@ -13,7 +13,11 @@
 #define _UTILS_HPP_
 
 #include <string>
+#include <string_view>
 #include <set>
+#include <streambuf>
+#include <istream>
+#include <vector>
 #include "arg_parser.hpp"
 
 /** Utils namespace */
@@ -78,6 +82,100 @@ namespace Utils {
     inline bool is_precise(float fitness) {
         return Args::arg_opts.precision > 0 && static_cast<unsigned>((fitness * 100)) >= Args::arg_opts.precision;
     }
+
+    /**
+     * Stream buffer reading directly from memory
+     * Used to pass text in memory to scanners (which read std::istream) without copying it
+     */
+    class MemoryBuffer : public std::streambuf {
+    public:
+        /**
+         * Constructor
+         * @param data Text to be read, it has to outlive the buffer
+         * @param size Size of data
+         */
+        MemoryBuffer(const char *data, size_t size) {
+            char *begin = const_cast<char *>(data);
+            this->setg(begin, begin, begin + size);
+        }
+
+        /**
+         * Reads the rest of the text at once without copying it
+         * @return Text which was not read yet
+         */
+        std::string_view take() {
+            std::string_view rest(this->gptr(), this->egptr() - this->gptr());
+            this->setg(this->eback(), this->egptr(), this->egptr());
+            return rest;
+        }
+    };
+
+    /**
+     * Input stream over a file mapped into memory
+     * Reading large files this way avoids read calls and copying through file stream buffers
+     */
+    class MappedFileStream : public std::istream {
+    private:
+        char *data;            ///< Mapped file content
+        size_t size;           ///< Size of the mapped file
+        MemoryBuffer buffer;   ///< Buffer reading the mapped content
+
+        /** Constructor, use open */
+        MappedFileStream(char *data, size_t size);
+    public:
+        /** Destructor, unmaps the file */
+        ~MappedFileStream();
+
+        /**
+         * Maps file into memory
+         * @param file_name Path to the file
+         * @return Stream over the mapped file or nullptr if the file cannot be mapped
+         *         (it is not a regular file, it is empty or could not be opened)
+         */
+        static MappedFileStream *open(const char *file_name);
+
+        /**
+         * Reads the rest of the file at once without copying it
+         * @return Mapped content which was not read yet, valid until the stream is deleted
+         */
+        std::string_view take() { return buffer.take(); }
+    };
+
+    /**
+     * Output stream buffer writing directly into a file descriptor
+     * Output is gathered in a large buffer and written by write/writev calls without any
+     * other buffering layer (stdio, filebuf). Terminal output is flushed after every line.
+     */
+    class FdOutputBuffer : public std::streambuf {
+    private:
+        static const size_t BUFFER_SIZE = 1 << 20;  ///< Size of the output buffer
+
+        int fd;                    ///< Output file descriptor
+        bool owns_fd;              ///< If true, fd is closed in the destructor
+        bool line_buffered;        ///< Flush at every new line
+        std::vector<char> buffer;  ///< Output buffer
+
+        /**
+         * Writes buffered output followed by data into fd
+         * @param data Data to write after the buffer, can be nullptr
+         * @param size Size of data
+         * @return true if everything was written
+         */
+        bool write_out(const char *data, size_t size);
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char *s, std::streamsize n) override;
+        int sync() override;
+    public:
+        /**
+         * Constructor
+         * @param fd File descriptor to write into
+         * @param owns_fd If true, fd will be closed by the destructor
+         */
+        FdOutputBuffer(int fd, bool owns_fd=false);
+        /** Destructor, flushes the buffer */
+        ~FdOutputBuffer();
+    };
 }
 
 /**
@@ -92,15 +190,36 @@ namespace Cast {
      * @param v Value
      */
     template<typename T>
-    T to(std::string v);
+    T to(const std::string &v);
 
     /// @note Default base (base 10) is used
-    template<> unsigned int to(std::string v);
+    template<> unsigned int to(const std::string &v);
 
     /// @note Default base (base 10) is used
-    template<> int to(std::string v);
+    template<> int to(const std::string &v);
+
+    template<> float to(const std::string &v);
+
+    /** Size of a buffer, which can hold any number written by format */
+    const size_t FORMAT_BUFFER_SIZE = 64;
 
-    template<> float to(std::string v);
+    /**
+     * Writes number as text without any allocation
+     * @param value Number to be written
+     * @param buffer Buffer of at least FORMAT_BUFFER_SIZE characters
+     * @return Written text (view into the buffer)
+     */
+    std::string_view format(int value, char *buffer);
+
+    /**
+     * Writes float as the shortest text, which is parsed back into the same value
+     * Decimal notation is always used and the text always contains a decimal point
+     * (e.g. 8.0, not 8), so that the value is scanned again as a FLOAT.
+     * @param value Number to be written
+     * @param buffer Buffer of at least FORMAT_BUFFER_SIZE characters
+     * @return Written text (view into the buffer)
+     */
+    std::string_view format(float value, char *buffer);
 }
 
 #endif//_UTILS_HPP_
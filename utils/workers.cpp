@@ -0,0 +1,127 @@
+/**
+ * @file workers.cpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Worker pool
+ *
+ * Pool of worker threads used to spread independent tasks
+ * (phenotype evaluations, interpreted files...) across cores.
+ */
+
+#include "workers.hpp"
+#include "arg_parser.hpp"
+#include "compiler.hpp"
+
+/** Set while the thread runs a task of a parallel batch */
+static thread_local bool running_task = false;
+
+WorkerPool::WorkerPool(size_t workers) : task{nullptr}, tasks{0}, next_task{0},
+                                         working{0}, batch_id{0}, stop{false},
+                                         failure{nullptr} {
+    // Calling thread works as well, so one less thread is needed
+    for(size_t i = 1; i < workers; ++i) {
+        threads.emplace_back(&WorkerPool::worker_loop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    batch_cv.notify_all();
+    for(auto &t: threads) {
+        // Destructor can be run by one of the workers (program exit from a task)
+        if(t.get_id() == std::this_thread::get_id()) {
+            t.detach();
+        }
+        else {
+            t.join();
+        }
+    }
+}
+
+WorkerPool &WorkerPool::get() {
+    static WorkerPool instance(Args::arg_opts.jobs > 0 ? Args::arg_opts.jobs : 1);
+    return instance;
+}
+
+bool WorkerPool::in_task() {
+    return running_task;
+}
+
+void WorkerPool::work(size_t worker) {
+    running_task = true;
+    for(size_t i = next_task++; i < tasks; i = next_task++) {
+        try {
+            (*task)(worker, i);
+        }
+        catch(...) {
+            std::lock_guard<std::mutex> guard(lock);
+            if(!failure) {
+                failure = std::current_exception();
+            }
+            // Skip the rest of the batch
+            next_task = tasks;
+        }
+    }
+    running_task = false;
+}
+
+void WorkerPool::worker_loop(size_t worker) {
+    size_t last_batch = 0;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            batch_cv.wait(guard, [&]{ return stop || batch_id != last_batch; });
+            if(stop) {
+                return;
+            }
+            last_batch = batch_id;
+        }
+        work(worker);
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            --working;
+        }
+        done_cv.notify_one();
+    }
+}
+
+void WorkerPool::run(size_t tasks, const TTask &task) {
+    if(threads.empty() || tasks < 2) {
+        // No need to wake up workers
+        for(size_t i = 0; i < tasks; ++i) {
+            task(0, i);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        this->task = &task;
+        this->tasks = tasks;
+        this->next_task = 0;
+        this->working = threads.size();
+        ++this->batch_id;
+    }
+    batch_cv.notify_all();
+    // Calling thread is worker 0
+    work(0);
+    std::unique_lock<std::mutex> guard(lock);
+    done_cv.wait(guard, [&]{ return working == 0; });
+    this->task = nullptr;
+    if(failure) {
+        auto e = failure;
+        failure = nullptr;
+        guard.unlock();
+        try {
+            std::rethrow_exception(e);
+        }
+        catch(const Error::ExitRequest &exit_req) {
+            // Calling thread is not in a task anymore, so this exits
+            Error::exit(exit_req.code);
+        }
+    }
+}
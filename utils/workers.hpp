@@ -0,0 +1,100 @@
+/**
+ * @file workers.hpp
+ * @author Marek Sedlacek
+ * @date October 2026
+ * @copyright Copyright 2026 Marek Sedlacek. All rights reserved.
+ *
+ * @brief Worker pool
+ *
+ * Pool of worker threads used to spread independent tasks
+ * (phenotype evaluations, interpreted files...) across cores.
+ */
+
+#ifndef _WORKERS_HPP_
+#define _WORKERS_HPP_
+
+#include <stddef.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+/**
+ * Pool of persistent worker threads
+ * Threads are created once and then wait for batches of tasks, so that
+ * running a batch for every GP iteration does not create new threads.
+ * When a task throws (or exits the program using Error::exit) the rest of the
+ * batch is skipped and the exception is rethrown from run in the calling thread.
+ * @note Batches cannot be nested, task function must not call run.
+ */
+class WorkerPool {
+public:
+    /**
+     * Task function
+     * First argument is the worker index (0 to size()-1) which can be used
+     * to index per worker data, second one is the task index
+     */
+    using TTask = std::function<void(size_t, size_t)>;
+private:
+    std::vector<std::thread> threads;  ///< Worker threads (calling thread is worker 0)
+    std::mutex lock;                   ///< Guards batch variables
+    std::condition_variable batch_cv;  ///< Notifies workers about new batch
+    std::condition_variable done_cv;   ///< Notifies calling thread about finished batch
+    const TTask *task;                 ///< Currently run task
+    size_t tasks;                      ///< Amount of tasks in current batch
+    std::atomic<size_t> next_task;     ///< Next task index to be taken
+    size_t working;                    ///< Amount of workers still working on current batch
+    size_t batch_id;                   ///< ID of the current batch
+    bool stop;                         ///< Set when pool is destroyed
+    std::exception_ptr failure;        ///< First exception thrown by a task of current batch
+
+    /**
+     * Takes tasks from the current batch until all are taken
+     * @param worker Index of the worker
+     */
+    void work(size_t worker);
+
+    /**
+     * Worker thread loop
+     * @param worker Index of the worker
+     */
+    void worker_loop(size_t worker);
+public:
+    /**
+     * Constructor
+     * @param workers Amount of workers including the calling thread
+     */
+    WorkerPool(size_t workers);
+    /** Destructor, joins all threads */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &other) = delete;
+    WorkerPool &operator=(const WorkerPool &other) = delete;
+
+    /**
+     * Pool instance getter
+     * Pool is created with Args::arg_opts.jobs workers
+     * @return Worker pool instance
+     */
+    static WorkerPool &get();
+
+    /**
+     * Runs task for every index from 0 to tasks-1 and waits for all of them to finish
+     * @param tasks Amount of tasks
+     * @param task Function called for each task
+     */
+    void run(size_t tasks, const TTask &task);
+
+    /**
+     * @return true if called from a task run in parallel by some pool
+     */
+    static bool in_task();
+
+    /** @return Amount of workers including the calling thread */
+    size_t size() const { return threads.size() + 1; }
+};
+
+#endif//_WORKERS_HPP_